@@ -0,0 +1,621 @@
+// bufcache.cc
+//	Routines to manage the sector buffer cache.
+//
+//	每个块有三个状态位：valid表示数据可用，busy表示正在进行磁盘I/O，
+//	pinCount表示正在被使用。访问磁盘时释放lock，让其他线程可以继续
+//	访问缓存中的其他块；等待某个块的线程在条件变量changed上睡眠。
+//
+//	写操作是延迟写回的：Unpin只把块标记为脏。后台写回线程在脏块
+//	太多或最旧的脏块太旧时被唤醒（系统空闲时由定时中断检查年龄），
+//	按扇区号顺序一次提交所有脏块的
+//	异步写请求。替换时优先选择干净的块；Flush（Sync/Fsync系统调用、
+//	关机时）同步写回所有脏块。预读也是异步提交的，不需要额外的线程。
+//
+// Copyright (c) 1992-1993 The Regents of the University of California.
+// All rights reserved.  See copyright.h for copyright notice and limitation
+// of liability and disclaimer of warranty provisions.
+
+#include "copyright.h"
+#include "bufcache.h"
+#include "system.h"
+
+//----------------------------------------------------------------------
+// BufferCache::BufferCache
+// 	Initialize an empty cache of "size" sectors.
+//----------------------------------------------------------------------
+
+BufferCache::BufferCache(int size)
+{
+    ASSERT(size > 0);
+    numBlocks = size;
+    blocks = new CacheBlock[numBlocks];
+    buckets = new int[numBlocks];
+    for (int i = 0; i < numBlocks; i++) {
+        blocks[i].sector = -1;
+        blocks[i].valid = FALSE;
+        blocks[i].dirty = FALSE;
+        blocks[i].busy = FALSE;
+        blocks[i].pinCount = 0;
+        blocks[i].lastUsed = 0;
+        blocks[i].dirtySince = 0;
+        blocks[i].holdCount = 0;
+        blocks[i].hashNext = -1;
+        buckets[i] = -1;
+    }
+    clock = 0;
+    lock = new Lock("buffer cache lock");
+    changed = new Condition("buffer cache");
+    numDirty = 0;
+    oldestDirty = 0;
+    flushPending = FALSE;
+    ageCheckPending = FALSE;
+    flushRequest = new Semaphore("buffer cache flush", 0);
+    writesInFlight = 0;
+}
+
+//----------------------------------------------------------------------
+// BufferCache::~BufferCache
+// 	Write back everything that is dirty, then free the cache.
+//----------------------------------------------------------------------
+
+BufferCache::~BufferCache()
+{
+    Flush();
+    delete flushRequest;
+    delete changed;
+    delete lock;
+    delete [] buckets;
+    delete [] blocks;
+}
+
+//----------------------------------------------------------------------
+// BufferCache::ReadSector/WriteSector
+// 	Same as SynchDisk::ReadSector/WriteSector, but served from the
+//	cache when possible.
+//----------------------------------------------------------------------
+
+void
+BufferCache::ReadSector(int sector, char *data)
+{
+    char *cached = Pin(sector, TRUE);
+    bcopy(cached, data, SectorSize);
+    Unpin(sector, FALSE);
+}
+
+void
+BufferCache::WriteSector(int sector, char *data)
+{
+    char *cached = Pin(sector, FALSE);	// 整个扇区都会被覆盖
+    bcopy(data, cached, SectorSize);
+    Unpin(sector, TRUE);
+}
+
+//----------------------------------------------------------------------
+// BufferCache::Pin
+// 	Return the cached copy of "sector", reading it from disk first
+//	if it is not in the cache and "fill" is set.  The block stays
+//	in the cache until the matching Unpin.
+//----------------------------------------------------------------------
+
+char *
+BufferCache::Pin(int sector, bool fill)
+{
+    ASSERT(sector >= 0 && sector < NumSectors);
+    return getBlock(sector, fill)->data;
+}
+
+//----------------------------------------------------------------------
+// BufferCache::Unpin
+// 	Release a block obtained by Pin.  If the caller modified the data,
+//	the block is marked dirty; it is written back later.
+//----------------------------------------------------------------------
+
+void
+BufferCache::Unpin(int sector, bool dirty)
+{
+    lock->Acquire();
+    CacheBlock *block = lookup(sector);
+    ASSERT(block != NULL && block->pinCount > 0);
+    block->valid = TRUE;		// 没有预先读入的块此时已经被完整写入
+    block->pinCount--;
+    if (dirty)
+        markDirty(block);
+    checkFlush();
+    changed->Broadcast(lock);
+    lock->Release();
+}
+
+//----------------------------------------------------------------------
+// BufferCache::Flush
+// 	Write every dirty block back to disk before returning.  Blocks
+//	held by the journal are left dirty until their transaction commits.
+//----------------------------------------------------------------------
+
+void
+BufferCache::Flush()
+{
+    lock->Acquire();
+    flushDirty();
+    for (int i = 0; i < numBlocks; i++) {	// 等待写回线程正在进行的写操作
+        while (blocks[i].busy || (blocks[i].dirty && blocks[i].holdCount == 0)) {
+            if (blocks[i].dirty)
+                writeBlock(&blocks[i]);
+            else
+                changed->Wait(lock);
+        }
+    }
+    lock->Release();
+}
+
+//----------------------------------------------------------------------
+// BufferCache::FlushSectors
+// 	Like Flush, but only for the "count" sectors in "sectors" (the data
+//	of one file, for Fsync), so one small file does not have to wait for
+//	every dirty block in the system.  Sectors that are not cached, or
+//	are held by the journal, are skipped.
+//----------------------------------------------------------------------
+
+void
+BufferCache::FlushSectors(int *sectors, int count)
+{
+    lock->Acquire();
+    for (int i = 0; i < count; i++) {	// 先全部提交，由磁盘调度合并相邻的扇区
+        CacheBlock *block = lookup(sectors[i]);
+        if (block != NULL && block->dirty && !block->busy && block->holdCount == 0)
+            submitWrite(block);
+    }
+    for (int i = 0; i < count; i++) {
+        CacheBlock *block;
+        while ((block = lookup(sectors[i])) != NULL
+               && (block->busy || (block->dirty && block->holdCount == 0))) {
+            if (block->dirty)
+                writeBlock(block);
+            else
+                changed->Wait(lock);
+        }
+    }
+    lock->Release();
+}
+
+//----------------------------------------------------------------------
+// BufferCache::Invalidate
+// 	Drop whatever is cached for the "count" sectors starting at
+//	"sector", dirty or not, without writing it back.  Used when they
+//	are about to be written straight to disk (Import), so that an old
+//	copy -- possibly a dirty block of a file removed since -- is never
+//	read or written over the new contents.
+//----------------------------------------------------------------------
+
+void
+BufferCache::Invalidate(int sector, int count)
+{
+    lock->Acquire();
+    for (int i = sector; i < sector + count; i++) {
+        CacheBlock *block;
+        while ((block = lookup(i)) != NULL && block->busy)
+            changed->Wait(lock);
+        if (block == NULL)
+            continue;
+        ASSERT(block->pinCount == 0 && block->holdCount == 0);
+        if (block->dirty)
+            numDirty--;
+        hashRemove(block);
+        block->sector = -1;
+        block->valid = FALSE;
+        block->dirty = FALSE;
+    }
+    lock->Release();
+}
+
+//----------------------------------------------------------------------
+// BufferCache::StartFlusher/FlusherThread
+// 	The background write-back thread.  It sleeps until checkFlush
+//	decides there are too many or too old dirty blocks, or AgeCheck
+//	finds an old dirty block while the system is idle.
+//----------------------------------------------------------------------
+
+static void
+CacheFlusher(int arg)
+{
+    ((BufferCache *) arg)->FlusherThread();
+}
+
+static void
+DirtyAgeCheck(int arg)
+{
+    ((BufferCache *) arg)->AgeCheck();
+}
+
+void
+BufferCache::StartFlusher()
+{
+    Thread *flusher = new Thread("cache flusher");
+    flusher->Fork(CacheFlusher, (void *) this);
+}
+
+void
+BufferCache::FlusherThread()
+{
+    for (;;) {
+        flushRequest->P();
+        journal->Commit(FALSE);		// 已经提交的块才能写回
+        lock->Acquire();
+        DEBUG('f', "Flushing %d dirty sectors.\n", numDirty);
+        flushDirty();
+        flushPending = FALSE;
+        if (numDirty > 0 && !ageCheckPending) {	// 留下的块（如被Hold的）也要按时写回
+            ageCheckPending = TRUE;
+            interrupt->Schedule(DirtyAgeCheck, (int) this, DirtyMaxAge, TimerInt);
+        }
+        lock->Release();
+    }
+}
+
+//----------------------------------------------------------------------
+// CacheIoDone
+// 	Completion callback for the asynchronous reads and writes the cache
+//	submits to the disk.  Runs in the disk interrupt handler.
+//----------------------------------------------------------------------
+
+static void
+CacheIoDone(int arg)
+{
+    bufferCache->IoDone((CacheBlock *) arg);
+}
+
+//----------------------------------------------------------------------
+// BufferCache::IoDone
+// 	An asynchronous transfer for "block" has finished.  This runs with
+//	interrupts disabled and cannot take the lock; that is safe because
+//	no thread touches a busy block except to wait for it.
+//----------------------------------------------------------------------
+
+void
+BufferCache::IoDone(CacheBlock *block)
+{
+    if (!block->valid)			// 预读完成
+        block->valid = TRUE;
+    else				// 写回完成
+        writesInFlight--;
+    block->busy = FALSE;
+    changed->Broadcast(lock);
+}
+
+//----------------------------------------------------------------------
+// BufferCache::Hold/Unhold
+// 	The journal holds each sector of a transaction that has not been
+//	committed yet: the block stays in the cache and is not written
+//	home until the matching Unhold.  Flush leaves held blocks dirty.
+//----------------------------------------------------------------------
+
+void
+BufferCache::Hold(int sector)
+{
+    CacheBlock *block = getBlock(sector, TRUE);
+
+    lock->Acquire();
+    block->holdCount++;
+    block->pinCount--;
+    lock->Release();
+}
+
+void
+BufferCache::Unhold(int sector)
+{
+    lock->Acquire();
+    CacheBlock *block = lookup(sector);
+    ASSERT(block != NULL && block->holdCount > 0);
+    block->holdCount--;
+    checkFlush();
+    changed->Broadcast(lock);
+    lock->Release();
+}
+
+//----------------------------------------------------------------------
+// BufferCache::Prefetch/StartRead
+// 	Start reading "sector" into the cache and return without waiting.
+//	The caller goes on with the data it already has while the disk
+//	works; a later Pin of the sector waits only for whatever part of
+//	the transfer is still left.  Nothing is done if the sector is
+//	already cached or if the only free blocks are dirty (an
+//	asynchronous read never forces a write).
+//
+//	Prefetch is for read-ahead and is counted as such.  StartRead is
+//	for sectors the caller is about to Pin anyway: starting all of them
+//	first lets SynchDisk merge them into one multi-sector transfer.
+//----------------------------------------------------------------------
+
+void
+BufferCache::Prefetch(int sector)
+{
+    lock->Acquire();
+    if (startRead(sector))
+        stats->numPrefetches++;
+    lock->Release();
+}
+
+void
+BufferCache::StartRead(int sector)
+{
+    lock->Acquire();
+    startRead(sector);
+    lock->Release();
+}
+
+bool
+BufferCache::startRead(int sector)
+{
+    if (sector < 0 || sector >= NumSectors || lookup(sector) != NULL)
+        return FALSE;
+    CacheBlock *block = selectVictim();
+    if (block == NULL || block->dirty)
+        return FALSE;
+    hashRemove(block);
+    block->sector = sector;
+    block->valid = FALSE;
+    block->busy = TRUE;
+    block->lastUsed = ++clock;
+    hashInsert(block);
+    synchDisk->SubmitRead(sector, block->data, CacheIoDone, (int) block);
+    return TRUE;
+}
+
+//----------------------------------------------------------------------
+// BufferCache::flushDirty
+// 	Write back all dirty blocks that are not already being written, and
+//	wait for the writes to finish.  All of the writes are submitted
+//	before waiting, in sector order, so the disk scheduler sees the
+//	whole batch at once and can serve it in one sweep, merging runs of
+//	consecutive sectors into single transfers.  A block is
+//	marked clean when its write is submitted; the disk copies the data
+//	when the request is dispatched, so a change made in between is
+//	either written now or marks the block dirty again.
+//----------------------------------------------------------------------
+
+void
+BufferCache::flushDirty()
+{
+    int *order = new int[numBlocks];
+    int n = 0;
+    for (int i = 0; i < numBlocks; i++) {
+        if (blocks[i].dirty && !blocks[i].busy && blocks[i].holdCount == 0)
+            order[n++] = i;
+    }
+    for (int i = 1; i < n; i++) {	// 插入排序，n不超过缓存大小
+        int key = order[i], j = i - 1;
+        while (j >= 0 && blocks[order[j]].sector > blocks[key].sector) {
+            order[j + 1] = order[j];
+            j--;
+        }
+        order[j + 1] = key;
+    }
+
+    for (int i = 0; i < n; i++)
+        submitWrite(&blocks[order[i]]);
+    delete [] order;
+    while (writesInFlight > 0)
+        changed->Wait(lock);
+
+    oldestDirty = stats->totalTicks;	// 写回期间又变脏的块
+    for (int k = 0; k < numBlocks; k++) {
+        if (blocks[k].dirty && blocks[k].dirtySince < oldestDirty)
+            oldestDirty = blocks[k].dirtySince;
+    }
+}
+
+//----------------------------------------------------------------------
+// BufferCache::submitWrite
+// 	Start writing a dirty block back without waiting; IoDone marks it
+//	no longer busy.  Caller holds the lock.
+//----------------------------------------------------------------------
+
+void
+BufferCache::submitWrite(CacheBlock *block)
+{
+    block->dirty = FALSE;
+    block->busy = TRUE;
+    numDirty--;
+    writesInFlight++;
+    synchDisk->SubmitWrite(block->sector, block->data, CacheIoDone,
+                           (int) block);
+}
+
+//----------------------------------------------------------------------
+// BufferCache::AgeCheck
+// 	Timer interrupt handler.  checkFlush only runs when someone uses
+//	the cache, so without this a dirty block could sit in memory for
+//	ever once the system goes idle.  markDirty arms the timer when the
+//	first block becomes dirty; if the oldest dirty block is not old
+//	enough yet, re-arm for the remaining time.
+//----------------------------------------------------------------------
+
+void
+BufferCache::AgeCheck()
+{
+    ageCheckPending = FALSE;
+    if (flushPending || numDirty == 0)
+        return;				// 写回线程会处理，或者已经写完了
+    int age = stats->totalTicks - oldestDirty;
+    if (age >= DirtyMaxAge) {
+        flushPending = TRUE;
+        flushRequest->V();		// 中断处理程序中只能V，不能获取lock
+    } else {
+        ageCheckPending = TRUE;
+        interrupt->Schedule(DirtyAgeCheck, (int) this, DirtyMaxAge - age,
+                            TimerInt);
+    }
+}
+
+void
+BufferCache::markDirty(CacheBlock *block)
+{
+    if (block->dirty)
+        return;
+    block->dirty = TRUE;
+    block->dirtySince = stats->totalTicks;
+    if (numDirty++ == 0)
+        oldestDirty = block->dirtySince;
+    if (!ageCheckPending) {
+        ageCheckPending = TRUE;
+        interrupt->Schedule(DirtyAgeCheck, (int) this, DirtyMaxAge, TimerInt);
+    }
+}
+
+void
+BufferCache::checkFlush()
+{
+    if (flushPending || numDirty == 0)
+        return;
+    if (numDirty * 100 >= numBlocks * DirtyHighWater
+            || stats->totalTicks - oldestDirty > DirtyMaxAge) {
+        flushPending = TRUE;
+        flushRequest->V();
+    }
+}
+
+//----------------------------------------------------------------------
+// BufferCache::getBlock
+// 	Find or load the block holding "sector" and pin it.
+//
+//	命中时只需要等待正在读入的块；不命中时用LRU选出一个没有被pin住的块，
+//	如果是脏块先写回，然后重新查找（写回期间其他线程可能已经读入了
+//	这个扇区）。fill为FALSE时不读磁盘，块在Unpin之前保持无效，
+//	其他线程会等待调用者写完数据。
+//----------------------------------------------------------------------
+
+CacheBlock *
+BufferCache::getBlock(int sector, bool fill)
+{
+    CacheBlock *block;
+
+    lock->Acquire();
+    for (;;) {
+        block = lookup(sector);
+        if (block != NULL) {
+            if (block->valid) {
+                stats->numCacheHits++;
+                checkFlush();
+                break;
+            }
+            changed->Wait(lock);	// 其他线程正在读入或写入该扇区
+            continue;
+        }
+
+        block = selectVictim();
+        if (block == NULL) {		// 所有块都在使用中
+            changed->Wait(lock);
+            continue;
+        }
+        if (block->dirty) {
+            writeBlock(block);
+            continue;
+        }
+
+        stats->numCacheMisses++;
+        hashRemove(block);
+        block->sector = sector;
+        block->valid = FALSE;
+        hashInsert(block);
+        if (fill) {
+            block->busy = TRUE;
+            block->pinCount++;		// 读入期间不能被替换
+            lock->Release();
+            synchDisk->ReadSector(sector, block->data);
+            lock->Acquire();
+            block->pinCount--;
+            block->busy = FALSE;
+            block->valid = TRUE;
+            changed->Broadcast(lock);
+        }
+        break;
+    }
+    block->pinCount++;
+    block->lastUsed = ++clock;
+    lock->Release();
+    return block;
+}
+
+//----------------------------------------------------------------------
+// BufferCache::writeBlock
+// 	Write a dirty block back to disk.  The lock is released during the
+//	transfer; the block is marked clean before the write starts, so a
+//	modification made while the write is in progress marks it dirty
+//	again and is not lost.
+//----------------------------------------------------------------------
+
+void
+BufferCache::writeBlock(CacheBlock *block)
+{
+    while (block->busy)			// 同一个块同时只能有一次I/O
+        changed->Wait(lock);
+    if (!block->dirty)
+        return;
+    block->dirty = FALSE;
+    numDirty--;
+    block->busy = TRUE;
+    lock->Release();
+    synchDisk->WriteSector(block->sector, block->data);
+    lock->Acquire();
+    block->busy = FALSE;
+    changed->Broadcast(lock);
+}
+
+CacheBlock *
+BufferCache::lookup(int sector)
+{
+    for (int i = buckets[sector % numBlocks]; i != -1; i = blocks[i].hashNext) {
+        if (blocks[i].sector == sector)
+            return &blocks[i];
+    }
+    return NULL;
+}
+
+//----------------------------------------------------------------------
+// BufferCache::selectVictim
+// 	Pick the least recently used block that nobody is using.  A free
+//	block is always preferred, then a clean one, so that a miss does
+//	not have to wait for a write.  Return NULL if every block is pinned
+//	or busy.
+//----------------------------------------------------------------------
+
+CacheBlock *
+BufferCache::selectVictim()
+{
+    CacheBlock *clean = NULL, *dirty = NULL;
+
+    for (int i = 0; i < numBlocks; i++) {
+        CacheBlock *block = &blocks[i];
+        if (block->pinCount > 0 || block->busy || block->holdCount > 0)
+            continue;
+        if (block->sector == -1)
+            return block;
+        CacheBlock **victim = block->dirty ? &dirty : &clean;
+        if (*victim == NULL || block->lastUsed < (*victim)->lastUsed)
+            *victim = block;
+    }
+    if (clean == NULL && dirty != NULL && !flushPending) {
+        flushPending = TRUE;		// 缓存里全是脏块
+        flushRequest->V();
+    }
+    return (clean != NULL) ? clean : dirty;
+}
+
+void
+BufferCache::hashInsert(CacheBlock *block)
+{
+    int bucket = block->sector % numBlocks;
+    block->hashNext = buckets[bucket];
+    buckets[bucket] = block - blocks;
+}
+
+void
+BufferCache::hashRemove(CacheBlock *block)
+{
+    if (block->sector == -1)
+        return;
+    int *link = &buckets[block->sector % numBlocks];
+    while (*link != block - blocks)
+        link = &blocks[*link].hashNext;
+    *link = block->hashNext;
+    block->hashNext = -1;
+}
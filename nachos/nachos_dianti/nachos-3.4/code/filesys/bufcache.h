@@ -0,0 +1,101 @@
+// bufcache.h
+//	Data structures for the sector buffer cache that sits between
+//	the file system and the synchronous disk.
+//
+//	文件系统所有的扇区读写（文件数据、文件头、目录、位图）都经过缓存，
+//	命中时直接在内存中拷贝，不命中时才通过synchDisk访问磁盘。
+//	缓存满时按LRU替换没有被pin住的块。
+//
+// Copyright (c) 1992-1993 The Regents of the University of California.
+// All rights reserved.  See copyright.h for copyright notice and limitation
+// of liability and disclaimer of warranty provisions.
+
+#include "copyright.h"
+
+#ifndef BUFCACHE_H
+#define BUFCACHE_H
+
+#include "disk.h"
+#include "synch.h"
+
+#define DefaultCacheSize 64 // 默认缓存的扇区数，可以用 -bc 修改
+#define DirtyMaxAge 200000  // 脏块在缓存中停留超过这么多ticks后唤醒写回线程
+#define DirtyHighWater 75   // 脏块超过缓存的这个百分比时唤醒写回线程
+
+// 缓存中的一个块，保存一个扇区的数据
+class CacheBlock {
+  public:
+    int sector;			// 缓存的扇区号，-1表示空闲
+    bool valid;			// 数据已经读入（或已经被完整写入）
+    bool dirty;			// 被修改过，还没有写回磁盘
+    bool busy;			// 正在和磁盘之间传输数据
+    int pinCount;		// 正在使用的线程数，大于0时不能被替换
+    int lastUsed;		// 最近一次被访问的时间，用于LRU
+    int dirtySince;		// 变脏的时间（totalTicks）
+    int holdCount;		// 日志中还没有提交的修改数，大于0时不能写回
+    int hashNext;		// 同一个散列桶中的下一个块，-1表示结束
+    char data[SectorSize];
+};
+
+// The following class defines the buffer cache.  ReadSector/WriteSector
+// have the same interface as SynchDisk; Pin/Unpin give direct access to
+// the cached copy of a sector, so callers that only touch part of a
+// sector do not need their own bounce buffer.
+class BufferCache {
+  public:
+    BufferCache(int size);		// 缓存size个扇区
+    ~BufferCache();			// 写回所有脏块
+
+    void ReadSector(int sector, char *data);
+    void WriteSector(int sector, char *data);
+
+    char *Pin(int sector, bool fill);	// 返回扇区在缓存中的数据，并pin住该块。
+					// fill为FALSE表示调用者会覆盖整个扇区，
+					// 不需要先从磁盘读入
+    void Unpin(int sector, bool dirty);	// 用完Pin返回的数据；dirty表示数据被修改
+
+    void Flush();			// 把所有脏块写回磁盘
+    void FlushSectors(int *sectors, int count); // 只写回这些扇区（Fsync）
+    void Invalidate(int sector, int count); // 丢掉这些扇区缓存的内容，不写回
+    void StartFlusher();		// 创建后台写回线程
+    void FlusherThread();		// 写回线程的主循环，不返回
+    void AgeCheck();			// 定时检查最旧脏块的年龄，由时钟中断调用
+
+    void Prefetch(int sector);		// 开始把扇区读入缓存，立即返回
+    void StartRead(int sector);		// 同上，但不算作预读
+    void IoDone(CacheBlock *block);	// 异步读写完成，由磁盘中断处理程序调用
+
+    void Hold(int sector);		// 在Unhold之前不把扇区写回磁盘（日志事务
+    void Unhold(int sector);		// 提交之前），也不替换
+    int NumBlocks() { return numBlocks; }
+
+  private:
+    CacheBlock *getBlock(int sector, bool fill);
+    bool startRead(int sector);		// 提交异步读，必须持有lock
+    CacheBlock *lookup(int sector);	// 在散列表中查找，必须持有lock
+    CacheBlock *selectVictim();		// LRU选择可以替换的块
+    void hashInsert(CacheBlock *block);
+    void hashRemove(CacheBlock *block);
+    void writeBlock(CacheBlock *block);	// 把脏块写回磁盘，期间释放lock
+    void submitWrite(CacheBlock *block);	// 提交脏块的写回，不等待完成
+    void markDirty(CacheBlock *block);
+    void flushDirty();			// 按扇区顺序提交所有脏块并等待写完
+    void checkFlush();			// 脏块太多或太旧时唤醒写回线程
+
+    CacheBlock *blocks;
+    int numBlocks;
+    int *buckets;			// 按扇区号散列，值为blocks的下标
+    int clock;				// 访问计数，作为LRU的时间
+    Lock *lock;				// 保护缓存的元数据
+    Condition *changed;			// 块的I/O完成或被unpin时广播
+
+    int numDirty;			// 当前的脏块数
+    int oldestDirty;			// 最早变脏的时间
+    bool flushPending;			// 已经唤醒了写回线程
+    bool ageCheckPending;		// 已经安排了AgeCheck中断
+    Semaphore *flushRequest;		// 写回线程在此等待
+
+    int writesInFlight;			// 已经提交还没有完成的写回请求
+};
+
+#endif // BUFCACHE_H
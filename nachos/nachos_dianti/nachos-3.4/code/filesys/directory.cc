@@ -1,265 +1,500 @@
-// directory.cc
-//	Routines to manage a directory of file names.
-//
-//	The directory is a table of fixed length entries; each
-//	entry represents a single file, and contains the file name,
-//	and the location of the file header on disk.  The fixed size
-//	of each directory entry means that we have the restriction
-//	of a fixed maximum size for file names.
-//
-//	The constructor initializes an empty directory of a certain size;
-//	we use ReadFrom/WriteBack to fetch the contents of the directory
-//	from disk, and to write back any modifications back to disk.
-//
-//	Also, this implementation has the restriction that the size
-//	of the directory cannot expand.  In other words, once all the
-//	entries in the directory are used, no more files can be created.
-//	Fixing this is one of the parts to the assignment.
-//
-// Copyright (c) 1992-1993 The Regents of the University of California.
-// All rights reserved.  See copyright.h for copyright notice and limitation
-// of liability and disclaimer of warranty provisions.
-
-#include "copyright.h"
-#include "utility.h"
-#include "filehdr.h"
-#include "directory.h"
-#include "system.h"
-#include <time.h>
-//----------------------------------------------------------------------
-// Directory::Directory
-// 	Initialize a directory; initially, the directory is completely
-//	empty.  If the disk is being formatted, an empty directory
-//	is all we need, but otherwise, we need to call FetchFrom in order
-//	to initialize it from disk.
-//
-//	"size" is the number of entries in the directory
-//----------------------------------------------------------------------
-
-/*
-@author lihaiyang
-无参数构造函数，真正的无限制文件夹的构造函数
-*/
-Directory::Directory()
-{
-    tableSize = 0;
-    table = NULL;
-}
-/*
- *
- * */
-Directory::Directory(int sec) {
-    OpenFile* openFile = new OpenFile(sec);
-    FetchFrom(openFile);
-    delete openFile;
-}
-//----------------------------------------------------------------------
-// Directory::~Directory
-// 	De-allocate directory data structure.
-//----------------------------------------------------------------------
-
-Directory::~Directory()
-{
-    if (table != NULL)
-        delete[] table;
-}
-
-//----------------------------------------------------------------------
-// Directory::FetchFrom
-// 	Read the contents of the directory from disk.
-//
-//	"file" -- file containing the directory contents
-//   存储格式如下：tablesize , Dentry , Dentry ...，先读取前4个字节的tablesize， 再依次读取
-//
-//----------------------------------------------------------------------
-
-void Directory::FetchFrom(OpenFile *file)
-{
-    (void)file->ReadAt((char*)(&tableSize), 4, 0); //读取entry数量
-
-    int fileSize = tableSize * sizeof(DirectoryEntry); // 获取entry 总字节数
-    table = new DirectoryEntry[tableSize];
-    (void)file->ReadAt((char *)table, fileSize, 4);
-}
-
-//----------------------------------------------------------------------
-// Directory::WriteBack
-// 	Write any modifications to the directory back to disk
-//
-//	"file" -- file to contain the new directory contents
-//----------------------------------------------------------------------
-
-void Directory::WriteBack(OpenFile *file)
-{
-    (void)file->WriteAt((char*)(&tableSize), 4, 0); //写入entry数量
-
-    (void)file->WriteAt((char *)table, tableSize * sizeof(DirectoryEntry), 4);
-}
-
-//----------------------------------------------------------------------
-// Directory::FindIndex
-// 	Look up file name in directory, and return its location in the table of
-//	directory entries.  Return -1 if the name isn't in the directory.
-//
-//	"name" -- the file name to look up
-//----------------------------------------------------------------------
-
-int Directory::FindIndex(char *name)
-{
-    for (int i = 0; i < tableSize; i++)
-        if (!strcmp(table[i].name, name))
-            return i;
-    return -1; // name not in directory
-}
-int Directory::FindIndex(int sec){
-    for (int i = 0; i < tableSize; i++)
-        if (table[i].sector == sec)
-            return i;
-    return -1; // name not in directory
-}
-//----------------------------------------------------------------------
-// Directory::Find
-// 	Look up file name in directory, and return the disk sector number
-//	where the file's header is stored. Return -1 if the name isn't
-//	in the directory.
-//
-//	"name" -- the file name to look up
-//----------------------------------------------------------------------
-
-int Directory::Find(char *name)
-{
-    int i = FindIndex(name);
-
-    if (i != -1)
-        return table[i].sector;
-    return -1;
-}
-
-//----------------------------------------------------------------------
-// Directory::Add
-// 	Add a file into the directory.  Return TRUE if successful;
-//	return FALSE if the file name is already in the directory, or if
-//	the directory is completely full, and has no more space for
-//	additional file names.
-//
-//	"name" -- the name of the file being added
-//	"newSector" -- the disk sector containing the added file's header
-//----------------------------------------------------------------------
-
-bool Directory::Add(char *name, int newSector, FileSystem* filesys, bool isFile, FileHeader* myHeader)
-{
-    if (FindIndex(name) != -1)
-        return FALSE;
-
-    /*  分配新的比原来大一个entry 的 table， 删除原来的*/
-    tableSize++;
-    myHeader->numBytes += sizeof(DirectoryEntry);
-    DirectoryEntry *newTable = new DirectoryEntry[tableSize];
-    memcpy((char*)newTable, (char*)table, sizeof(DirectoryEntry) * (tableSize - 1));
-    delete table;
-    table = newTable;
-    /*  拷贝名字*/
-    int nameLen = strlen(name);
-    if (nameLen > FileNameMaxLen)
-    { //  名字写入磁盘块 nameSector
-        int nameSector = filesys->findEmptySector();
-        table[tableSize - 1].nameDiskSector = nameSector;
-    }
-    else
-    {
-        strncpy(table[tableSize - 1].name, name, FileNameMaxLen);
-    }
-    time_t create;
-    time(&create);
-    table[tableSize - 1].createDate = (long)create;
-    table[tableSize - 1].sector = newSector;
-    if(isFile){
-        table[tableSize-1].isDirectory = FALSE;
-    }else{
-        table[tableSize-1].isDirectory = true;
-    }
-    return TRUE;
-}
-
-//----------------------------------------------------------------------
-// Directory::Remove
-// 	Remove a file name from the directory.  Return TRUE if successful;
-//	return FALSE if the file isn't in the directory.
-//
-//	"name" -- the file name to be removed
-//----------------------------------------------------------------------
-
-bool Directory::Remove(char *name)
-{
-    int i = FindIndex(name);
-
-    if (i == -1)
-        return FALSE; // name not in directory
-    tableSize --;
-    DirectoryEntry* buf = new DirectoryEntry[tableSize];
-    int firstPartSize = i * sizeof(DirectoryEntry);
-    int secondPartSize = (tableSize - i) * sizeof(DirectoryEntry);
-    memcpy((char*)buf, (char*)table, firstPartSize);
-    memcpy((char*)(buf + firstPartSize), (char*)(table + firstPartSize + sizeof(DirectoryEntry)), secondPartSize);
-    delete table;
-    table = buf;
-    return TRUE;
-}
-bool Directory::Remove(int sec){
-    int i = FindIndex(sec);
-
-    if (i == -1)
-        return FALSE; // name not in directory
-    tableSize --;
-    DirectoryEntry* buf = new DirectoryEntry[tableSize];
-    int firstPartSize = i * sizeof(DirectoryEntry);
-    int secondPartSize = (tableSize - i) * sizeof(DirectoryEntry);
-    memcpy((char*)buf, (char*)table, firstPartSize);
-    memcpy((char*)(buf + firstPartSize), (char*)(table + firstPartSize + sizeof(DirectoryEntry)), secondPartSize);
-    delete table;
-    table = buf;
-    return TRUE;
-}
-//----------------------------------------------------------------------
-// Directory::List
-// 	List all the file names in the directory.
-//----------------------------------------------------------------------
-
-void Directory::List()
-{
-    for (int i = 0; i < tableSize; i++){
-        if(!table[i].nameOnDisk){
-            printf("%s  ", table[i].name);
-        }else{
-            printf("too long name to show  ");
-        }
-        if(table[i].isDirectory){
-        	printf("d  ");
-        }else{
-        	printf("f  ");
-        }
-        time_t time = (time_t)table[i].createDate;
-        printf("%s\n",ctime(&time));
-    }
-            
-}
-
-//----------------------------------------------------------------------
-// Directory::Print
-// 	List all the file names in the directory, their FileHeader locations,
-//	and the contents of each file.  For debugging.
-//----------------------------------------------------------------------
-
-void Directory::Print()
-{
-    FileHeader *hdr = new FileHeader;
-    Directory* dir = new Directory();
-    printf("Directory contents:\n");
-    for (int i = 0; i < tableSize; i++){
-        printf("Name: %s, Sector: %d\n", table[i].name, table[i].sector);
-        hdr->FetchFrom(table[i].sector);
-        hdr->Print();
-    }
-    printf("\n");
-    delete hdr;
-}
+// directory.cc
+//	Routines to manage a directory of file names.
+//
+//	The directory is a table of fixed length entries; each
+//	entry represents a single file, and contains the file name,
+//	and the location of the file header on disk.  The fixed size
+//	of each directory entry means that we have the restriction
+//	of a fixed maximum size for file names.
+//
+//	The constructor initializes an empty directory of a certain size;
+//	we use ReadFrom/WriteBack to fetch the contents of the directory
+//	from disk, and to write back any modifications back to disk.
+//
+//	The directory is kept on disk as an open-addressing hash table
+//	keyed on the file name (see directory.h).  Find, Add and Remove
+//	read and write only the slots they probe, through the buffer cache,
+//	so their cost does not depend on the size of the directory.  The
+//	table doubles when it gets three quarters full (counting deleted
+//	slots), which is the only time the whole directory is rewritten.
+//
+// Copyright (c) 1992-1993 The Regents of the University of California.
+// All rights reserved.  See copyright.h for copyright notice and limitation
+// of liability and disclaimer of warranty provisions.
+
+#include "copyright.h"
+#include "utility.h"
+#include "filehdr.h"
+#include "directory.h"
+#include "system.h"
+#include <time.h>
+//----------------------------------------------------------------------
+// Directory::Directory
+// 	Initialize a directory; initially, the directory is completely
+//	empty.  If the disk is being formatted, an empty directory
+//	is all we need, but otherwise, we need to call FetchFrom in order
+//	to initialize it from disk.
+//
+//	Directory(sec) opens the directory file whose header is at "sec"
+//	itself, and keeps it open until the directory is deleted.
+//----------------------------------------------------------------------
+
+Directory::Directory()
+{
+    file = NULL;
+    ownFile = FALSE;
+    tableSize = 0;
+    table = NULL;
+    header.magic = DirectoryMagic;
+    header.numSlots = header.numUsed = header.numDeleted = 0;
+}
+
+Directory::Directory(int sec)
+{
+    file = NULL;
+    table = NULL;
+    tableSize = 0;
+    OpenFile* openFile = new OpenFile(sec);
+    openFile->filesys = fileSystem;
+    FetchFrom(openFile);
+    ownFile = TRUE;
+}
+
+//----------------------------------------------------------------------
+// Directory::~Directory
+// 	De-allocate directory data structure.  A directory that opened its
+//	own file closes it; the file header goes back to headerCache,
+//	marked dirty if the directory was written.
+//----------------------------------------------------------------------
+
+Directory::~Directory()
+{
+    if (table != NULL)
+        delete[] table;
+    if (ownFile)
+        delete file;
+}
+
+//----------------------------------------------------------------------
+// Directory::FetchFrom
+// 	Read the directory header from disk.  For the hash format that is
+//	all; slots are read when they are probed.  An old format directory
+//	(tableSize, then the entries) is read into memory whole, and is
+//	converted the first time it is changed.
+//
+//	"dirFile" -- file containing the directory contents
+//----------------------------------------------------------------------
+
+void Directory::FetchFrom(OpenFile *dirFile)
+{
+    file = dirFile;
+    file->journaled = TRUE;
+    ownFile = FALSE;
+    if (table != NULL)
+        delete[] table;
+    table = NULL;
+    if (file->ReadAt((char *) &header, sizeof(DirectoryHeader), 0)
+            < (int) sizeof(int) || header.magic != DirectoryMagic) {
+        header.numSlots = header.numUsed = header.numDeleted = 0;
+        (void)file->ReadAt((char*)(&tableSize), 4, 0); //读取entry数量
+        if (file->Length() < 4 || tableSize < 0)
+            tableSize = 0;
+
+        int fileSize = tableSize * sizeof(DirectoryEntry); // 获取entry 总字节数
+        table = new DirectoryEntry[tableSize + 1];
+        (void)file->ReadAt((char *)table, fileSize, 4);
+    }
+}
+
+//----------------------------------------------------------------------
+// Directory::WriteBack
+// 	Write any modifications to the directory back to disk.  Changes to
+//	slots are written as they are made, so only the header is left;
+//	an old format directory that was never changed stays as it is.
+//
+//	"dirFile" -- file to contain the new directory contents
+//----------------------------------------------------------------------
+
+void Directory::WriteBack(OpenFile *dirFile)
+{
+    if (dirFile != NULL && dirFile != file) { // 整个目录写到另一个文件，以后就用这个文件
+        int count;
+        int slots = isLegacy() || header.numSlots == 0 ? DirInitialSlots : header.numSlots;
+        DirectoryEntry *entries = readAll(&count);
+        while ((count + 1) * 4 > slots * 3)
+            slots *= 2;
+        if (ownFile)
+            delete file;
+        ownFile = FALSE;
+        file = dirFile;
+        file->journaled = TRUE;
+        ASSERT(rebuild(entries, count, slots));
+        delete[] entries;
+        return;
+    }
+    if (!isLegacy())
+        writeHeader();
+}
+
+//----------------------------------------------------------------------
+// Directory::hash
+// 	Hash a file name (djb2).
+//----------------------------------------------------------------------
+
+unsigned int Directory::hash(char *name)
+{
+    unsigned int h = 5381;
+    for (int i = 0; i < FileNameMaxLen && name[i] != '\0'; i++)
+        h = h * 33 + (unsigned char) name[i];
+    return h;
+}
+
+void Directory::readSlot(int i, DirectoryEntry *e)
+{
+    file->ReadAt((char *) e, sizeof(DirectoryEntry),
+                 sizeof(DirectoryHeader) + i * sizeof(DirectoryEntry));
+}
+
+void Directory::writeSlot(int i, DirectoryEntry *e)
+{
+    file->WriteAt((char *) e, sizeof(DirectoryEntry),
+                  sizeof(DirectoryHeader) + i * sizeof(DirectoryEntry));
+}
+
+void Directory::writeHeader()
+{
+    file->WriteAt((char *) &header, sizeof(DirectoryHeader), 0);
+}
+
+//----------------------------------------------------------------------
+// Directory::readAll
+// 	Return a new array holding every entry in use, and their number
+//	in "*count".  Used when the table is rebuilt and to list it.
+//----------------------------------------------------------------------
+
+DirectoryEntry *Directory::readAll(int *count)
+{
+    if (isLegacy()) {
+        DirectoryEntry *copy = new DirectoryEntry[tableSize + 1];
+        memcpy((char *) copy, (char *) table, tableSize * sizeof(DirectoryEntry));
+        *count = tableSize;
+        return copy;
+    }
+    if (file == NULL || header.numSlots == 0) {
+        *count = 0;
+        return new DirectoryEntry[1];
+    }
+    DirectoryEntry *slots = new DirectoryEntry[header.numSlots];
+    DirectoryEntry *entries = new DirectoryEntry[header.numUsed + 1];
+    int n = 0;
+    file->ReadAt((char *) slots, header.numSlots * sizeof(DirectoryEntry),
+                 sizeof(DirectoryHeader));
+    for (int i = 0; i < header.numSlots && n < header.numUsed; i++)
+        if (slots[i].sector != 0 && slots[i].sector != DirDeletedSlot)
+            entries[n++] = slots[i];
+    delete[] slots;
+    *count = n;
+    return entries;
+}
+
+//----------------------------------------------------------------------
+// Directory::rebuild
+// 	Write a fresh hash table of "slots" slots holding "entries" to the
+//	directory file, in one write, and switch to it.  Used to convert an
+//	old format directory and to grow the table.  Return FALSE, with the
+//	old table left as it was, if the disk has no room for the new one.
+//
+//	"freeMap" -- if not NULL, take the sectors from this bitmap and
+//	leave writing it back to the caller (Import)
+//----------------------------------------------------------------------
+
+bool Directory::rebuild(DirectoryEntry *entries, int count, int slots, BitMap *freeMap)
+{
+    int bytes = sizeof(DirectoryHeader) + slots * sizeof(DirectoryEntry);
+    // 先给整个新表分配扇区，磁盘满时旧表保持原样
+    if (bytes > InlineSize && freeMap != NULL) {
+        if (!file->hdr->Extend(freeMap, divRoundUp(bytes, SectorSize), FALSE))
+            return FALSE;
+    } else if (bytes > InlineSize && file->filesys != NULL
+            && !file->filesys->extendFile(file->hdr, divRoundUp(bytes, SectorSize),
+                                          FALSE, file->headerSector()))
+        return FALSE;
+
+    DirectoryEntry *newSlots = new DirectoryEntry[slots];
+
+    for (int i = 0; i < count; i++) {
+        unsigned int j = hash(entries[i].name) & (slots - 1);
+        while (newSlots[j].sector != 0)
+            j = (j + 1) & (slots - 1);
+        newSlots[j] = entries[i];
+    }
+    header.magic = DirectoryMagic;
+    header.numSlots = slots;
+    header.numUsed = count;
+    header.numDeleted = 0;
+    writeHeader();
+    file->WriteAt((char *) newSlots, slots * sizeof(DirectoryEntry),
+                  sizeof(DirectoryHeader));
+    delete[] newSlots;
+    if (table != NULL) {
+        delete[] table;
+        table = NULL;
+        tableSize = 0;
+    }
+    return TRUE;
+}
+
+//----------------------------------------------------------------------
+// Directory::FindIndex
+// 	Look up file name in directory, and return its location in the table of
+//	directory entries.  Return -1 if the name isn't in the directory.
+//	In the hash format this probes from the name's home slot until it
+//	finds the name or an empty slot.
+//
+//	"name" -- the file name to look up
+//----------------------------------------------------------------------
+
+int Directory::FindIndex(char *name)
+{
+    if (isLegacy()) {
+        for (int i = 0; i < tableSize; i++)
+            if (!strcmp(table[i].name, name))
+                return i;
+        return -1; // name not in directory
+    }
+    if (header.numSlots == 0)
+        return -1;
+    DirectoryEntry e;
+    unsigned int i = hash(name) & (header.numSlots - 1);
+    for (int n = 0; n < header.numSlots; n++, i = (i + 1) & (header.numSlots - 1)) {
+        readSlot(i, &e);
+        if (e.sector == 0)
+            return -1;
+        if (e.sector != DirDeletedSlot && !strcmp(e.name, name))
+            return i;
+    }
+    return -1; // name not in directory
+}
+
+//----------------------------------------------------------------------
+// Directory::Find
+// 	Look up file name in directory, and return the disk sector number
+//	where the file's header is stored. Return -1 if the name isn't
+//	in the directory.
+//
+//	"name" -- the file name to look up
+//----------------------------------------------------------------------
+
+int Directory::Find(char *name)
+{
+    int i = FindIndex(name);
+
+    if (i == -1)
+        return -1;
+    if (isLegacy())
+        return table[i].sector;
+    DirectoryEntry e;
+    readSlot(i, &e);
+    return e.sector;
+}
+
+//----------------------------------------------------------------------
+// Directory::Add
+// 	Add a file into the directory.  Return TRUE if successful;
+//	return FALSE if the file name is already in the directory.
+//	An old format directory is converted first.  The new entry goes
+//	into the first deleted or empty slot on the name's probe sequence;
+//	the table doubles first if it would get more than 3/4 full.  The
+//	whole new table is logged in one transaction, so a table too big
+//	for the journal (Journal::CanLog) does not double: it fills up to
+//	one empty slot short of full, then Add fails.
+//
+//	"name" -- the name of the file being added
+//	"newSector" -- the disk sector containing the added file's header
+//----------------------------------------------------------------------
+
+bool Directory::Add(char *name, int newSector, FileSystem* filesys, bool isFile)
+{
+    if (FindIndex(name) != -1)
+        return FALSE;
+
+    if (isLegacy() || header.numSlots == 0
+            || (header.numUsed + header.numDeleted + 1) * 4 > header.numSlots * 3) {
+        int count;
+        DirectoryEntry *entries = readAll(&count);
+        int slots = (header.numSlots > 0 && !isLegacy()) ? header.numSlots : DirInitialSlots;
+        while ((count + 1) * 4 > slots * 3)
+            slots *= 2;
+        int sectors = divRoundUp(sizeof(DirectoryHeader) + slots * sizeof(DirectoryEntry),
+                                 SectorSize);
+        bool rebuilt = TRUE;
+        if (isLegacy() || header.numSlots == 0 || journal->CanLog(sectors))
+            rebuilt = rebuild(entries, count, slots);
+        delete[] entries;
+        if (!rebuilt || header.numUsed + header.numDeleted + 2 > header.numSlots)
+            return FALSE;       // 目录满了，探测序列上至少要留一个空槽位
+    }
+
+    DirectoryEntry entry;
+    /*  拷贝名字*/
+    int nameLen = strlen(name);
+    if (nameLen > FileNameMaxLen)
+    { //  名字写入磁盘块 nameSector
+        int nameSector = filesys->findEmptySector();
+        entry.nameDiskSector = nameSector;
+    }
+    else
+    {
+        strncpy(entry.name, name, FileNameMaxLen);
+    }
+    time_t create;
+    time(&create);
+    entry.createDate = (long)create;
+    entry.sector = newSector;
+    if(isFile){
+        entry.isDirectory = FALSE;
+    }else{
+        entry.isDirectory = true;
+    }
+
+    DirectoryEntry e;
+    unsigned int i = hash(entry.name) & (header.numSlots - 1);
+    for (;; i = (i + 1) & (header.numSlots - 1)) { // 负载不超过3/4，一定有空槽位
+        readSlot(i, &e);
+        if (e.sector == 0 || e.sector == DirDeletedSlot)
+            break;
+    }
+    if (e.sector == DirDeletedSlot)
+        header.numDeleted--;
+    header.numUsed++;
+    writeSlot(i, &entry);
+    writeHeader();
+    return TRUE;
+}
+
+//----------------------------------------------------------------------
+// Directory::AddAll
+// 	Add "count" entries at once, for Import: the table is rebuilt a
+//	single time, big enough for them all, instead of growing (and
+//	being rewritten) again and again.  The caller has checked that
+//	the names are not in the directory yet.  Return FALSE if the disk
+//	is full; the directory is then left as it was.
+//
+//	"freeMap" -- the sectors for a bigger table come from here; the
+//	caller writes the bitmap back
+//----------------------------------------------------------------------
+
+bool Directory::AddAll(DirectoryEntry *added, int count, BitMap *freeMap)
+{
+    int n;
+    DirectoryEntry *old = readAll(&n);
+    DirectoryEntry *entries = new DirectoryEntry[n + count];
+
+    for (int i = 0; i < n; i++)
+        entries[i] = old[i];
+    for (int i = 0; i < count; i++)
+        entries[n + i] = added[i];
+    int slots = (header.numSlots > 0 && !isLegacy()) ? header.numSlots : DirInitialSlots;
+    while ((n + count + 1) * 4 > slots * 3)
+        slots *= 2;
+    bool success = rebuild(entries, n + count, slots, freeMap);
+    delete[] old;
+    delete[] entries;
+    return success;
+}
+
+//----------------------------------------------------------------------
+// Directory::Remove
+// 	Remove a file name from the directory.  Return TRUE if successful;
+//	return FALSE if the file isn't in the directory.  The slot found
+//	by probing for the name becomes a tombstone, so that probe
+//	sequences going through it still work.
+//
+//	"name" -- the file name to be removed
+//----------------------------------------------------------------------
+
+bool Directory::Remove(char *name)
+{
+    int i = FindIndex(name);
+
+    if (i == -1)
+        return FALSE; // name not in directory
+    if (isLegacy()) {  // 先转换成散列格式
+        int count;
+        DirectoryEntry *entries = readAll(&count);
+        int slots = DirInitialSlots;
+        while (count * 4 > slots * 3)
+            slots *= 2;
+        bool rebuilt = rebuild(entries, count, slots);
+        delete[] entries;
+        if (!rebuilt)
+            return FALSE; // 磁盘满了，没法转换
+        i = FindIndex(name);
+    }
+    DirectoryEntry tomb;
+    tomb.sector = DirDeletedSlot;
+    writeSlot(i, &tomb);
+    header.numUsed--;
+    header.numDeleted++;
+    writeHeader();
+    return TRUE;
+}
+
+//----------------------------------------------------------------------
+// Directory::Entries
+// 	Return a copy of every entry in the directory, and their number in
+//	"*count", for callers that walk the tree.
+//----------------------------------------------------------------------
+
+DirectoryEntry *Directory::Entries(int *count)
+{
+    return readAll(count);
+}
+
+//----------------------------------------------------------------------
+// Directory::List
+// 	List all the file names in the directory.
+//----------------------------------------------------------------------
+
+void Directory::List()
+{
+    int count;
+    DirectoryEntry *entries = readAll(&count);
+
+    for (int i = 0; i < count; i++){
+        if(!entries[i].nameOnDisk){
+            printf("%s  ", entries[i].name);
+        }else{
+            printf("too long name to show  ");
+        }
+        if(entries[i].isDirectory){
+        	printf("d  ");
+        }else{
+        	printf("f  ");
+        }
+        time_t time = (time_t)entries[i].createDate;
+        printf("%s\n",ctime(&time));
+    }
+    delete[] entries;
+}
+
+//----------------------------------------------------------------------
+// Directory::Print
+// 	List all the file names in the directory, their FileHeader locations,
+//	and the contents of each file.  For debugging.
+//----------------------------------------------------------------------
+
+void Directory::Print()
+{
+    int count;
+    DirectoryEntry *entries = readAll(&count);
+    printf("Directory contents:\n");
+    for (int i = 0; i < count; i++){
+        printf("Name: %s, Sector: %d\n", entries[i].name, entries[i].sector);
+        FileHeader *hdr = headerCache->Get(entries[i].sector);
+        hdr->Print();
+        headerCache->Release(hdr, FALSE);
+    }
+    printf("\n");
+    delete[] entries;
+}
@@ -1,105 +1,139 @@
-// directory.h
-//	Data structures to manage a UNIX-like directory of file names.
-//
-//      A directory is a table of pairs: <file name, sector #>,
-//	giving the name of each file in the directory, and
-//	where to find its file header (the data structure describing
-//	where to find the file's data blocks) on disk.
-//
-//      We assume mutual exclusion is provided by the caller.
-//
-// Copyright (c) 1992-1993 The Regents of the University of California.
-// All rights reserved.  See copyright.h for copyright notice and limitation
-// of liability and disclaimer of warranty provisions.
-
-#include "copyright.h"
-
-#ifndef DIRECTORY_H
-#define DIRECTORY_H
-
-#include "openfile.h"
-#include "list.h"
-#define FileNameMaxLen 9 // for simplicity, we assume
-                         // file names are <= 9 characters long
-
-// The following class defines a "directory entry", representing a file
-// in the directory.  Each entry gives the name of the file, and where
-// the file's header is to be found on disk.
-//
-// Internal data structures kept public so that Directory operations can
-// access them directly.
-/*
- 目录项
- 1. 标识当前目录项是一个文件还是目录文件
- 2. 标识名称，或者长名称存储在一个磁盘块，给出磁盘块号
- 3. 标识文件头的磁盘块号。
-*/
-class DirectoryEntry    
-{
-public:
-	DirectoryEntry(){
-		isDirectory = false;
-		nameOnDisk = false;
-		nameDiskSector = -1;
-		createDate = 0;
-		lastChangeDate = 0;
-		sector = 0;
-	};
-    bool isDirectory;   // 是否是目录
-    bool nameOnDisk;     // 名称是否在磁盘块
-    int nameDiskSector;   //名称在磁盘块的位置
-    long createDate;    // 标准时间,  创建时间
-    long lastChangeDate;   //标准时间， 上次修改
-
-    int sector;                    // Location on disk to find the
-                                   //   FileHeader for this file
-    char name[FileNameMaxLen + 1] = {}; // Text name for file, with +1 for
-                                   // the trailing '\0'
-};
-
-// The following class defines a UNIX-like "directory".  Each entry in
-// the directory describes a file, and where to find it on disk.
-//
-// The directory data structure can be stored in memory, or on disk.
-// When it is on disk, it is stored as a regular Nachos file.
-//
-// The constructor initializes a directory structure in memory; the
-// FetchFrom/WriteBack operations shuffle the directory information
-// from/to disk.
-class FileSystem;
-class FileHeader;
-class Directory
-{
-public:
-    Directory();
-    Directory(int sec);
-    ~Directory();        // De-allocate the directory
-
-    void FetchFrom(OpenFile *file); // Init directory contents from disk
-    void WriteBack(OpenFile *file); // Write modifications to
-                                    // directory contents back to disk
-
-    int Find(char *name); // Find the sector number of the
-                          // FileHeader for file: "name"
-
-    bool Add(char *name, int newSector, FileSystem* filesys, bool isFile, FileHeader* myHeader); // Add a file name into the directory
-
-    bool Remove(char *name); // Remove a file from the directory
-    bool Remove(int sec);
-    void List();  // Print the names of all the files
-                  //  in the directory
-    void Print(); // Verbose print of the contents
-                  //  of the directory -- all the file
-                  //  names and their contents.
-
-private:
-    int tableSize;         // Number of directory entries
-    DirectoryEntry* table;           // Table of pairs:
-                           // <file name, file header location>
-
-    int FindIndex(char *name); // Find the index into the directory
-                               //  table corresponding to "name"
-    int FindIndex(int sec);
-};
-
-#endif // DIRECTORY_H
+// directory.h
+//	Data structures to manage a UNIX-like directory of file names.
+//
+//      A directory is a table of pairs: <file name, sector #>,
+//	giving the name of each file in the directory, and
+//	where to find its file header (the data structure describing
+//	where to find the file's data blocks) on disk.
+//
+//      We assume mutual exclusion is provided by the caller.
+//
+//	目录文件是一个开放寻址的散列表：目录头DirectoryHeader之后是
+//	numSlots（2的幂）个DirectoryEntry槽位，按文件名散列，线性探测。
+//	sector为0的槽位是空的，为DirDeletedSlot的是删除留下的墓碑。
+//	查找、插入、删除只读写探测到的那几个槽位，不把整个目录读进内存。
+//	旧格式（开头是表项数，后面紧跟所有表项）仍然可以读，第一次修改时
+//	转换成散列格式。
+//
+// Copyright (c) 1992-1993 The Regents of the University of California.
+// All rights reserved.  See copyright.h for copyright notice and limitation
+// of liability and disclaimer of warranty provisions.
+
+#include "copyright.h"
+
+#ifndef DIRECTORY_H
+#define DIRECTORY_H
+
+#include "openfile.h"
+#include "list.h"
+#define FileNameMaxLen 9 // for simplicity, we assume
+                         // file names are <= 9 characters long
+#define DirectoryMagic 0x48446972 // 散列格式的目录
+#define DirInitialSlots 16  // 新目录的槽位数
+#define DirDeletedSlot (-1) // 墓碑的sector
+
+// The following class defines a "directory entry", representing a file
+// in the directory.  Each entry gives the name of the file, and where
+// the file's header is to be found on disk.
+//
+// Internal data structures kept public so that Directory operations can
+// access them directly.
+/*
+ 目录项
+ 1. 标识当前目录项是一个文件还是目录文件
+ 2. 标识名称，或者长名称存储在一个磁盘块，给出磁盘块号
+ 3. 标识文件头的磁盘块号。
+*/
+class DirectoryEntry    
+{
+public:
+	DirectoryEntry(){
+		isDirectory = false;
+		nameOnDisk = false;
+		nameDiskSector = -1;
+		createDate = 0;
+		lastChangeDate = 0;
+		sector = 0;
+	};
+    bool isDirectory;   // 是否是目录
+    bool nameOnDisk;     // 名称是否在磁盘块
+    int nameDiskSector;   //名称在磁盘块的位置
+    long createDate;    // 标准时间,  创建时间
+    long lastChangeDate;   //标准时间， 上次修改
+
+    int sector;                    // Location on disk to find the
+                                   //   FileHeader for this file
+    char name[FileNameMaxLen + 1] = {}; // Text name for file, with +1 for
+                                   // the trailing '\0'
+};
+
+// 散列格式的目录文件开头
+class DirectoryHeader
+{
+public:
+    int magic;          // DirectoryMagic
+    int numSlots;       // 槽位数，2的幂
+    int numUsed;        // 有文件的槽位数
+    int numDeleted;     // 墓碑数
+};
+
+// The following class defines a UNIX-like "directory".  Each entry in
+// the directory describes a file, and where to find it on disk.
+//
+// The directory data structure can be stored in memory, or on disk.
+// When it is on disk, it is stored as a regular Nachos file.
+//
+// The constructor initializes a directory structure in memory; the
+// FetchFrom/WriteBack operations shuffle the directory information
+// from/to disk.
+class FileSystem;
+class FileHeader;
+class BitMap;
+class Directory
+{
+public:
+    Directory();
+    Directory(int sec);  // 打开sec扇区上的目录文件，析构时关闭
+    ~Directory();        // De-allocate the directory
+
+    void FetchFrom(OpenFile *dirFile); // Init directory contents from disk
+    void WriteBack(OpenFile *dirFile = NULL); // Write modifications to
+                                    // directory contents back to disk
+                                    // (NULL: the file it was fetched from)
+
+    int Find(char *name); // Find the sector number of the
+                          // FileHeader for file: "name"
+
+    bool Add(char *name, int newSector, FileSystem* filesys, bool isFile); // Add a file name into the directory
+
+    bool AddAll(DirectoryEntry *added, int count, BitMap *freeMap); // 一次加入多个表项（Import），
+                          // 新的扇区从freeMap分配，不写回位图
+    bool Remove(char *name); // Remove a file from the directory
+    DirectoryEntry *Entries(int *count); // 所有的表项，调用者delete[]
+    void List();  // Print the names of all the files
+                  //  in the directory
+    void Print(); // Verbose print of the contents
+                  //  of the directory -- all the file
+                  //  names and their contents.
+
+private:
+    OpenFile *file;        // 目录文件，散列格式的槽位直接在其中读写
+    bool ownFile;          // file由Directory(int sec)打开，析构时关闭
+    DirectoryHeader header;
+
+    int tableSize;         // 旧格式：Number of directory entries
+    DirectoryEntry* table;           // 旧格式：Table of pairs:
+                           // <file name, file header location>
+
+    int FindIndex(char *name); // Find the index into the directory
+                               //  table corresponding to "name"
+    bool isLegacy() { return table != NULL; }
+    void readSlot(int i, DirectoryEntry *e);
+    void writeSlot(int i, DirectoryEntry *e);
+    void writeHeader();
+    DirectoryEntry *readAll(int *count); // 所有有文件的表项
+    bool rebuild(DirectoryEntry *entries, int count, int slots, BitMap *freeMap = NULL); // 用entries重建散列表，磁盘满时返回FALSE
+    static unsigned int hash(char *name);
+};
+
+#endif // DIRECTORY_H
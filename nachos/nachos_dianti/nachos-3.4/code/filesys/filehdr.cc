@@ -1,220 +1,848 @@
-// filehdr.cc
-//	Routines for managing the disk file header (in UNIX, this
-//	would be called the i-node).
-//
-//	The file header is used to locate where on disk the
-//	file's data is stored.  We implement this as a fixed size
-//	table of pointers -- each entry in the table points to the
-//	disk sector containing that portion of the file data
-//	(in other words, there are no indirect or doubly indirect
-//	blocks). The table size is chosen so that the file header
-//	will be just big enough to fit in one disk sector,
-//
-//      Unlike in a real system, we do not keep track of file permissions,
-//	ownership, last modification date, etc., in the file header.
-//
-//	A file header can be initialized in two ways:
-//	   for a new file, by modifying the in-memory data structure
-//	     to point to the newly allocated data blocks
-//	   for a file already on disk, by reading the file header from disk
-//
-// Copyright (c) 1992-1993 The Regents of the University of California.
-// All rights reserved.  See copyright.h for copyright notice and limitation
-// of liability and disclaimer of warranty provisions.
-
-#include "copyright.h"
-
-#include "system.h"
-#include "filehdr.h"
-
-FileHeader::FileHeader(){
-	numBytes = 0;
-	numSectors = 0;
-	for(int i = 0; i < NumIndex; i ++){
-		dataSectors[i] = 0;
-	}
-}
-
-//----------------------------------------------------------------------
-// FileHeader::Allocate
-// 	Initialize a fresh file header for a newly created file.
-//	Allocate data blocks for the file out of the map of free disk blocks.
-//	Return FALSE if there are not enough free blocks to accomodate
-//	the new file.
-//
-//	"freeMap" is the bit map of free disk sectors
-//	"fileSize" is the bit map of free disk sectors
-//----------------------------------------------------------------------
-
-bool FileHeader::Allocate(BitMap *freeMap, int fileSize)
-{
-    numBytes = fileSize;
-    numSectors = divRoundUp(fileSize, SectorSize);
-    if(numSectors < NumDirectIndex){
-        if (freeMap->NumClear() < numSectors)
-            return FALSE; // not enough space
-        for (int i = 0; i < numSectors; i++){
-            dataSectors[i] = freeMap->Find();
-        }
-    }else if(numSectors < Num2Index){
-        if (freeMap->NumClear() < numSectors + 1)
-            return FALSE; // not enough space
-        for (int i = 0; i < NumDirectIndex; i++){
-            dataSectors[i] = freeMap->Find();
-        }
-        dataSectors[NumDirectIndex] = freeMap->Find();
-        int* buf = new int[SectorSize/sizeof(int)];
-        for(int i = 0; i < numSectors - NumDirectIndex; i ++){
-            buf[i] = freeMap->Find();
-        }
-        synchDisk->WriteSector(dataSectors[NumDirectIndex], (char *)buf);
-    }else {
-    	return FALSE;
-    }
-
-    return TRUE;
-}
-
-//----------------------------------------------------------------------
-// FileHeader::Deallocate
-// 	De-allocate all the space allocated for data blocks for this file.
-//
-//	"freeMap" is the bit map of free disk sectors
-//----------------------------------------------------------------------
-
-void FileHeader::Deallocate(BitMap *freeMap)
-{
-    for (int i = 0; i < numSectors; i++)
-    {
-        ASSERT(freeMap->Test((int)dataSectors[i])); // ought to be marked!
-        freeMap->Clear((int)dataSectors[i]);
-    }
-}
-
-//----------------------------------------------------------------------
-// FileHeader::FetchFrom
-// 	Fetch contents of file header from disk.
-//
-//	"sector" is the disk sector containing the file header
-//----------------------------------------------------------------------
-
-void FileHeader::FetchFrom(int sector)
-{
-    synchDisk->ReadSector(sector, (char *)this);
-}
-
-//----------------------------------------------------------------------
-// FileHeader::WriteBack
-// 	Write the modified contents of the file header back to disk.
-//
-//	"sector" is the disk sector to contain the file header
-//----------------------------------------------------------------------
-
-void FileHeader::WriteBack(int sector)
-{
-    synchDisk->WriteSector(sector, (char *)this);
-}
-
-//----------------------------------------------------------------------
-// FileHeader::ByteToSector
-// 	Return which disk sector is storing a particular byte within the file.
-//      This is essentially a translation from a virtual address (the
-//	offset in the file) to a physical address (the sector where the
-//	data at the offset is stored).
-//
-//	"offset" is the location within the file of the byte in question
-//  如果查找的offset相对应的sector还没有申请，则申请新的sector并返回申请结果，
-//  如果超过了一级索引的范围，则需要申请二级索引并进行对应磁盘块的返回
-//   传入虚拟文件系统的指针是为了通过文件系统申请新的磁盘块
-//----------------------------------------------------------------------
-
-int FileHeader::ByteToSector(int offset, FileSystem* filesys)
-{
-    int index = offset / SectorSize;
-    if(index >= numSectors){    // 长度变化，写操作会发生
-        numSectors ++;
-        int secNum = filesys->findEmptySector();
-        if(secNum == -1){
-            ASSERT(FALSE);
-        }
-        if(index == NumDirectIndex){   //需要新建二级映射
-            dataSectors[index] = secNum;
-            secNum = filesys->findEmptySector();
-            if(secNum == -1)
-                ASSERT(FALSE);
-            int* buf = new int[SectorSize / sizeof(int)];
-            buf[0] = secNum;
-            synchDisk->WriteSector(dataSectors[index], (char*)buf);
-            return secNum;
-        }else if(index > NumDirectIndex){  //已经存在二级映射
-            int* buf = new int[SectorSize / sizeof(int)];
-            synchDisk->ReadSector(dataSectors[NumDirectIndex], (char*)buf);
-            buf[index - NumDirectIndex] = secNum;
-            synchDisk->WriteSector(dataSectors[NumDirectIndex], (char*)buf);
-            return secNum;
-        }else{     // 一级映射
-            dataSectors[index] = secNum;
-            return secNum;
-        }
-    }else{        // 长度不变化，不需要新分配磁盘块
-        if(index < NumDirectIndex){     // 一级映射
-            return dataSectors[index];
-        }else{      // 二级映射
-            int* buf = new int[SectorSize / sizeof(4)];
-            return buf[index - NumDirectIndex];
-        }
-    }
-
-}
-
-//----------------------------------------------------------------------
-// FileHeader::FileLength
-// 	Return the number of bytes in the file.
-//----------------------------------------------------------------------
-
-int FileHeader::FileLength()
-{
-    return numBytes;
-}
-
-//----------------------------------------------------------------------
-// FileHeader::Print
-// 	Print the contents of the file header, and the contents of all
-//	the data blocks pointed to by the file header.
-//----------------------------------------------------------------------
-
-void FileHeader::Print()
-{
-    int i, j, k;
-    char *data = new char[SectorSize];
-
-    printf("FileHeader contents.  File size: %d.  File blocks:\n", numBytes);
-    for (i = 0; i < numSectors; i++)
-        printf("%d ", dataSectors[i]);
-    printf("\nFile contents:\n");
-    for (i = k = 0; i < numSectors; i++)
-    {
-        synchDisk->ReadSector(dataSectors[i], data);
-        for (j = 0; (j < SectorSize) && (k < numBytes); j++, k++)
-        {
-            if ('\040' <= data[j] && data[j] <= '\176') // isprint(data[j])
-                printf("%c", data[j]);
-            else
-                printf("\\%x", (unsigned char)data[j]);
-        }
-        printf("\n");
-    }
-    delete[] data;
-}
-
-bool FileHeader::init(FileSystem* fileSystem) {
-	numSectors = 1;
-	numBytes = 4;
-    int sec = fileSystem->findEmptySector();
-    if(sec == -1)
-        return FALSE;
-    dataSectors[0] = sec;
-    char buf[SectorSize] = {};
-    synchDisk->WriteSector(sec, buf);
-    return TRUE;
-}
+// filehdr.cc
+//	Routines for managing the disk file header (in UNIX, this
+//	would be called the i-node).
+//
+//	The file header is used to locate where on disk the
+//	file's data is stored.  We implement this as a table of extents --
+//	each entry describes a run of consecutive disk sectors holding
+//	consecutive sectors of the file.  The first NumDirectExtents
+//	extents are kept in the header itself, which is just big enough
+//	to fit in one disk sector.  The rest go in extent blocks, reached
+//	through single, double and triple indirect pointers, as in UNIX:
+//	with 10 extents per block and 32 pointers per pointer block this
+//	is over ten thousand extents, so the size of a file is limited by
+//	the disk rather than by its header.
+//
+//	Data sectors are allocated a run at a time: growing a file first
+//	tries to continue its last extent in place, and otherwise takes
+//	the best-fitting run of free sectors from the bitmap.  A growing
+//	file also gets some sectors beyond what it asked for, so that the
+//	next writes stay contiguous; those are given back when the file is
+//	closed for the last time (FileHeader::Trim).
+//
+//	Files may be sparse.  Sectors no extent covers are holes: they read
+//	as zeros and take no disk space until they are first written, so
+//	writing far past the end of a file only allocates what it touches.
+//
+//      Unlike in a real system, we do not keep track of file permissions,
+//	ownership, last modification date, etc., in the file header.
+//
+//	A file header can be initialized in two ways:
+//	   for a new file, by modifying the in-memory data structure
+//	     to point to the newly allocated data blocks
+//	   for a file already on disk, by reading the file header from disk
+//
+// Copyright (c) 1992-1993 The Regents of the University of California.
+// All rights reserved.  See copyright.h for copyright notice and limitation
+// of liability and disclaimer of warranty provisions.
+
+#include "copyright.h"
+
+#include "system.h"
+#include "filehdr.h"
+#include "filesys.h"
+
+// 旧格式的文件头：numBytes, numSectors, dataSectors[30]，
+// 前29个是数据扇区号，第30个指向存放其余扇区号的间接块
+#define LegacyNumDirect 29
+
+FileHeader::FileHeader(){
+	indexCache = NULL;
+	indexClock = 0;
+	extentHint = 0;
+	cached = NULL;
+	reset();
+}
+
+FileHeader::~FileHeader(){
+	if (indexCache != NULL)
+		delete[] indexCache;
+}
+
+//----------------------------------------------------------------------
+// FileHeader::reset
+// 	Make the header describe an empty file, with no index blocks.
+//----------------------------------------------------------------------
+
+void FileHeader::reset(){
+	magic = FileHeaderMagic;
+	numBytes = 0;
+	numSectors = 0;
+	numExtents = 0;
+	flags = 0;
+	for(int i = 0; i < NumIndirect; i ++){
+		indirect[i] = -1;
+	}
+	for(int i = 0; i < NumDirectExtents; i ++){
+		extents[i].logical = extents[i].start = extents[i].length = 0;
+	}
+	if (indexCache != NULL)
+		for (int i = 0; i < IndexCacheSize; i++)
+			indexCache[i].sector = -1;
+	extentHint = 0;
+}
+
+//----------------------------------------------------------------------
+// FileHeader::Allocate
+// 	Initialize a fresh file header for a newly created file.
+//	Allocate data blocks for the file out of the map of free disk blocks.
+//	Return FALSE if there are not enough free blocks to accomodate
+//	the new file.
+//
+//	"freeMap" is the bit map of free disk sectors
+//	"fileSize" is the bit map of free disk sectors
+//----------------------------------------------------------------------
+
+bool FileHeader::Allocate(BitMap *freeMap, int fileSize)
+{
+    int sectors = divRoundUp(fileSize, SectorSize);
+
+    numBytes = fileSize;
+    if (freeMap->NumClear() < sectors)
+        return FALSE; // not enough space
+    return Extend(freeMap, sectors, FALSE);
+}
+
+//----------------------------------------------------------------------
+// FileHeader::Extend
+// 	Allocate data sectors at the end of the file until it has at least
+//	"sectors" of them.  Each run is taken right after the file's last
+//	extent if those sectors are free, otherwise from the best-fitting
+//	free run in the bitmap.  With "prealloc", the file gets extra
+//	sectors beyond that -- as many as it already has, between
+//	MinPrealloc and MaxPrealloc -- if there is room for them.
+//
+//	Return FALSE if the disk (or the extent table) is full before the
+//	file has "sectors" sectors.
+//----------------------------------------------------------------------
+
+bool FileHeader::Extend(BitMap *freeMap, int sectors, bool prealloc)
+{
+    int target = sectors;
+
+    if (sectors <= numSectors)
+        return TRUE;
+    char *promoted = NULL;
+    if (IsInline()) {           // 内容要搬到第一个数据扇区
+        promoted = new char[SectorSize];
+        bzero(promoted, SectorSize);
+        bcopy(inlineData(), promoted, InlineSize);
+        flags &= ~HdrInline;
+        for (int i = 0; i < NumIndirect; i++)
+            indirect[i] = -1;
+        for (int i = 0; i < NumDirectExtents; i++)
+            extents[i].logical = extents[i].start = extents[i].length = 0;
+    }
+    if (prealloc) {
+        int extra = (numSectors < MaxPrealloc) ? numSectors : MaxPrealloc;
+        target += (extra < MinPrealloc) ? MinPrealloc : extra;
+    }
+    while (numSectors < target) {
+        int want = target - numSectors;
+        int start = -1, got = 0;
+        Extent last;
+
+        if (numExtents > 0) {   // 先试着接在最后一个extent后面（中间有空洞时留出空洞的位置）
+            getExtent(numExtents - 1, &last);
+            start = last.start + (numSectors - last.logical);
+            got = freeMap->MarkRun(start, want);
+        }
+        if (got == 0) {
+            start = freeMap->FindRun(want, &got);
+            if (start == -1)
+                break;          // 磁盘满了
+        }
+        if (!addRun(freeMap, start, got)) {
+            for (int i = 0; i < got; i++)
+                freeMap->Clear(start + i);
+            break;              // extent表满了
+        }
+    }
+    if (promoted != NULL) {
+        if (numSectors > 0) {
+            bufferCache->WriteSector(extents[0].start, promoted);
+            journal->Log(extents[0].start);     // 和文件头的变化一起提交
+        } else {                // 一个扇区也没有分到，仍然放在文件头里
+            flags |= HdrInline;
+            bcopy(promoted, inlineData(), InlineSize);
+        }
+        delete [] promoted;
+    }
+    return numSectors >= sectors;
+}
+
+//----------------------------------------------------------------------
+// FileHeader::Fill
+// 	Allocate a disk sector for sector "logical" of the file, which is
+//	a hole.  Past the last extent the file grows as in Extend (with
+//	preallocation if "prealloc"), leaving a hole between the old end
+//	and "logical" if they are not adjacent.  A hole inside the file gets exactly one
+//	sector, placed right after the data before it if that is free.
+//
+//	Return FALSE if the disk or the extent table is full.
+//----------------------------------------------------------------------
+
+bool FileHeader::Fill(BitMap *freeMap, int logical, bool prealloc)
+{
+    Extent prev, next, e;
+    int k = 0;
+
+    if (IsInline()) {           // 先把内容搬到第0个扇区
+        if (!Extend(freeMap, 1, prealloc && logical == 0))
+            return FALSE;
+        if (Lookup(logical * SectorSize) != -1)
+            return TRUE;
+    }
+    if (logical >= numSectors) {
+        int oldSectors = numSectors;
+        numSectors = logical;   // 中间是空洞
+        if (Extend(freeMap, logical + 1, prealloc))
+            return TRUE;
+        if (numSectors == logical)  // 一个扇区也没有分到
+            numSectors = oldSectors;
+        return FALSE;
+    }
+
+    if (numExtents > 0) {       // 第k个extent是空洞之后的第一个
+        k = findExtent(logical);
+        getExtent(k, &e);
+        if (e.logical <= logical)
+            k++;
+    }
+    ASSERT(k < numExtents);
+    getExtent(k, &next);
+    int got, sector = -1;
+    if (k > 0) {
+        getExtent(k - 1, &prev);
+        sector = prev.start + (logical - prev.logical);
+        if (freeMap->MarkRun(sector, 1) == 0)
+            sector = -1;
+    }
+    if (sector == -1 && (sector = freeMap->FindRun(1, &got)) == -1)
+        return FALSE;
+
+    if (k > 0 && prev.logical + prev.length == logical
+            && prev.start + prev.length == sector) {
+        prev.length++;          // 接在前一个extent后面
+        putExtent(k - 1, &prev, freeMap);
+    } else if (next.logical == logical + 1 && next.start == sector + 1) {
+        next.logical--;         // 接在后一个extent前面
+        next.start--;
+        next.length++;
+        putExtent(k, &next, freeMap);
+    } else {
+        if (numExtents == MaxExtents) {
+            freeMap->Clear(sector);
+            return FALSE;
+        }
+        e.logical = logical;
+        e.start = sector;
+        e.length = 1;
+        insertExtent(k, &e, freeMap);
+    }
+    return TRUE;
+}
+
+//----------------------------------------------------------------------
+// FileHeader::insertExtent
+// 	Make "e" the i-th extent, moving the ones from i on up by one.
+//----------------------------------------------------------------------
+
+void FileHeader::insertExtent(int i, Extent *e, BitMap *freeMap)
+{
+    Extent moved;
+
+    for (int j = numExtents; j > i; j--) {
+        getExtent(j - 1, &moved);
+        ASSERT(putExtent(j, &moved, freeMap));  // 间接块分配失败时磁盘已满
+    }
+    putExtent(i, e, freeMap);
+    numExtents++;
+    extentHint = 0;
+}
+
+//----------------------------------------------------------------------
+// FileHeader::addRun
+// 	Append "length" sectors starting at disk sector "start" to the end
+//	of the file.  A run that continues the last extent, both in the
+//	file and on disk, just makes it longer.  Return FALSE if a new extent is needed and there is no
+//	room for one (or no "freeMap" to allocate an index block from).
+//----------------------------------------------------------------------
+
+bool FileHeader::addRun(BitMap *freeMap, int start, int length)
+{
+    Extent e;
+
+    if (numExtents > 0) {
+        getExtent(numExtents - 1, &e);
+        if (e.start + e.length == start && e.logical + e.length == numSectors) {
+            e.length += length;
+            putExtent(numExtents - 1, &e, freeMap);
+            numSectors += length;
+            return TRUE;
+        }
+    }
+    if (numExtents == MaxExtents)
+        return FALSE;
+    e.logical = numSectors;
+    e.start = start;
+    e.length = length;
+    if (!putExtent(numExtents, &e, freeMap))
+        return FALSE;
+    numExtents++;
+    numSectors += length;
+    return TRUE;
+}
+
+//----------------------------------------------------------------------
+// FileHeader::getExtent/putExtent
+// 	Read/write the i-th extent of the file, which is either in the
+//	header or in one of its extent blocks.  putExtent allocates the
+//	index blocks on the way to a new extent block from "freeMap"; it
+//	returns FALSE if it needs one and cannot get it.
+//----------------------------------------------------------------------
+
+void FileHeader::getExtent(int i, Extent *e)
+{
+    int slot;
+
+    ASSERT(i >= 0 && i < MaxExtents);
+    if (i < NumDirectExtents) {
+        *e = extents[i];
+        return;
+    }
+    int sector = extentBlock(i, &slot, NULL);
+    ASSERT(sector != -1);
+    IndexBlock *block = loadIndex(sector, TRUE);
+    bcopy(block->data + slot * sizeof(Extent), (char *) e, sizeof(Extent));
+}
+
+bool FileHeader::putExtent(int i, Extent *e, BitMap *freeMap)
+{
+    int slot;
+
+    ASSERT(i >= 0 && i < MaxExtents);
+    if (i < NumDirectExtents) {
+        extents[i] = *e;
+        return TRUE;
+    }
+    int sector = extentBlock(i, &slot, freeMap);
+    if (sector == -1)
+        return FALSE;
+    IndexBlock *block = loadIndex(sector, TRUE);
+    bcopy((char *) e, block->data + slot * sizeof(Extent), sizeof(Extent));
+    block->dirty = TRUE;
+    return TRUE;
+}
+
+//----------------------------------------------------------------------
+// FileHeader::extentBlock
+// 	Return the sector of the extent block holding extent "i" (which
+//	must be past the direct extents), and its slot in that block.
+//	Extent blocks are numbered from 0 after the direct extents: block 0
+//	hangs off indirect[0], the next PointersPerSector off the pointer
+//	block at indirect[1], and the rest off the two levels of pointer
+//	blocks under indirect[2].
+//
+//	Missing index blocks are allocated from "freeMap"; with no
+//	"freeMap" (or a full disk) return -1 instead.
+//----------------------------------------------------------------------
+
+int FileHeader::extentBlock(int i, int *slot, BitMap *freeMap)
+{
+    int n = i - NumDirectExtents;
+    int block = n / ExtentsPerSector;
+    int level;
+
+    *slot = n % ExtentsPerSector;
+    if (block == 0) {
+        level = 1;
+    } else if (block - 1 < PointersPerSector) {
+        block -= 1;
+        level = 2;
+    } else {
+        block -= 1 + PointersPerSector;
+        level = 3;
+    }
+
+    int *root = &indirect[level - 1];
+    if (*root == -1) {
+        if (freeMap == NULL || (*root = newIndexBlock(freeMap)) == -1) {
+            *root = -1;
+            return -1;
+        }
+    }
+    int sector = *root;
+    for (int l = level; l > 1; l--) {   // 沿着指针块往下走
+        int idx = (l == 3) ? block / PointersPerSector : block % PointersPerSector;
+        int next = ((int *) loadIndex(sector, TRUE)->data)[idx];
+        if (next == -1 && freeMap != NULL) {
+            next = newIndexBlock(freeMap);
+            IndexBlock *b = loadIndex(sector, TRUE); // newIndexBlock可能换出了它
+            ((int *) b->data)[idx] = next;
+            b->dirty = TRUE;
+        }
+        if (next == -1)
+            return -1;
+        sector = next;
+    }
+    return sector;
+}
+
+//----------------------------------------------------------------------
+// FileHeader::newIndexBlock
+// 	Allocate a sector for an index block, with every entry set to -1.
+//	It is taken from the smallest hole in the free map, so that it does
+//	not land right after the file's data and break up the next extent.
+//	The block only exists in the header's cache until WriteBack.
+//----------------------------------------------------------------------
+
+int FileHeader::newIndexBlock(BitMap *freeMap)
+{
+    int got;
+    int sector = freeMap->FindRun(1, &got);
+
+    if (sector == -1)
+        return -1;
+    IndexBlock *block = loadIndex(sector, FALSE);
+    memset(block->data, 0xff, SectorSize);
+    block->dirty = TRUE;
+    return sector;
+}
+
+//----------------------------------------------------------------------
+// FileHeader::releaseIndex/freeIndex
+// 	Free the index blocks that only hold extents from numExtents on.
+//	freeIndex handles the subtree at "*sector": an extent block if
+//	"level" is 1, otherwise a pointer block whose entries each cover
+//	the extents of a level-1 subtree.  "first" is the number of the
+//	first extent under it.
+//----------------------------------------------------------------------
+
+void FileHeader::releaseIndex(BitMap *freeMap)
+{
+    int first = NumDirectExtents;
+
+    if (IsInline())             // indirect里是文件内容
+        return;
+    freeIndex(freeMap, &indirect[0], 1, first);
+    first += ExtentsPerSector;
+    freeIndex(freeMap, &indirect[1], 2, first);
+    first += ExtentsPerSector * PointersPerSector;
+    freeIndex(freeMap, &indirect[2], 3, first);
+}
+
+void FileHeader::freeIndex(BitMap *freeMap, int *sector, int level, int first)
+{
+    if (*sector == -1)
+        return;
+    if (level > 1) {
+        int span = (level == 3) ? ExtentsPerSector * PointersPerSector
+                                : ExtentsPerSector;
+        int ptrs[PointersPerSector];	// 子树会用到缓存，先拷出来
+        bool changed = FALSE;
+
+        bcopy(loadIndex(*sector, TRUE)->data, (char *) ptrs, SectorSize);
+        for (int k = 0; k < PointersPerSector; k++) {
+            int old = ptrs[k];
+            freeIndex(freeMap, &ptrs[k], level - 1, first + k * span);
+            changed = changed || (ptrs[k] != old);
+        }
+        if (changed && first < numExtents) {
+            IndexBlock *b = loadIndex(*sector, TRUE);
+            bcopy((char *) ptrs, b->data, SectorSize);
+            b->dirty = TRUE;
+        }
+    }
+    if (first >= numExtents) {
+        dropIndex(*sector);
+        freeMap->Clear(*sector);
+        *sector = -1;
+    }
+}
+
+//----------------------------------------------------------------------
+// FileHeader::loadIndex
+// 	Return the header's cached copy of index block "sector", reading
+//	it in if "fill" and it is not loaded yet.  Each open header keeps
+//	the index blocks it has used (up to IndexCacheSize, least recently
+//	used out first), so mapping offsets past the direct extents costs
+//	no disk reads or buffer cache lookups after the first.  Changes
+//	are made in place and reach the disk with the header's WriteBack.
+//----------------------------------------------------------------------
+
+IndexBlock *FileHeader::loadIndex(int sector, bool fill)
+{
+    IndexBlock *victim = NULL;
+
+    if (indexCache == NULL) {
+        indexCache = new IndexBlock[IndexCacheSize];
+        for (int i = 0; i < IndexCacheSize; i++)
+            indexCache[i].sector = -1;
+    }
+    for (int i = 0; i < IndexCacheSize; i++) {
+        IndexBlock *b = &indexCache[i];
+        if (b->sector == sector) {
+            b->lastUsed = ++indexClock;
+            return b;
+        }
+        if (victim == NULL || b->sector == -1
+                || (victim->sector != -1 && b->lastUsed < victim->lastUsed))
+            victim = b;
+    }
+    if (victim->sector != -1 && victim->dirty) {
+        bufferCache->WriteSector(victim->sector, victim->data);
+        journal->Log(victim->sector);
+    }
+    victim->sector = sector;
+    victim->dirty = FALSE;
+    victim->lastUsed = ++indexClock;
+    if (fill)
+        bufferCache->ReadSector(sector, victim->data);
+    return victim;
+}
+
+//----------------------------------------------------------------------
+// FileHeader::dropIndex/flushIndex
+// 	dropIndex forgets a cached index block without writing it (the
+//	block is being freed).  flushIndex writes the changed ones back;
+//	with "forget" the cache is emptied as well.
+//----------------------------------------------------------------------
+
+void FileHeader::dropIndex(int sector)
+{
+    if (indexCache == NULL)
+        return;
+    for (int i = 0; i < IndexCacheSize; i++)
+        if (indexCache[i].sector == sector)
+            indexCache[i].sector = -1;
+}
+
+void FileHeader::flushIndex(bool forget)
+{
+    if (indexCache == NULL)
+        return;
+    for (int i = 0; i < IndexCacheSize; i++) {
+        IndexBlock *b = &indexCache[i];
+        if (b->sector != -1 && b->dirty) {
+            bufferCache->WriteSector(b->sector, b->data);
+            journal->Log(b->sector);
+        }
+        b->dirty = FALSE;
+        if (forget)
+            b->sector = -1;
+    }
+}
+
+//----------------------------------------------------------------------
+// FileHeader::findExtent
+// 	Return the index of the extent holding sector "logical" of the
+//	file.  The extent found last time, and the one after it, are tried
+//	first, which is all sequential access needs; otherwise extents are
+//	in file order, so this is a binary search.  If "logical" is in a
+//	hole, the result is the last extent before it (or extent 0), so
+//	the caller has to check.
+//----------------------------------------------------------------------
+
+int FileHeader::findExtent(int logical)
+{
+    int lo = 0, hi = numExtents - 1;
+    Extent e;
+
+    ASSERT(logical >= 0 && logical < numSectors);
+    for (int i = extentHint; i < extentHint + 2 && i < numExtents; i++) {
+        getExtent(i, &e);
+        if (e.logical <= logical && logical < e.logical + e.length)
+            return extentHint = i;
+    }
+    while (lo < hi) {
+        int mid = (lo + hi + 1) / 2;
+        getExtent(mid, &e);
+        if (e.logical <= logical)
+            lo = mid;
+        else
+            hi = mid - 1;
+    }
+    extentHint = lo;
+    return lo;
+}
+
+//----------------------------------------------------------------------
+// FileHeader::Deallocate
+// 	De-allocate all the space allocated for data blocks for this file.
+//
+//	"freeMap" is the bit map of free disk sectors
+//----------------------------------------------------------------------
+
+void FileHeader::Deallocate(BitMap *freeMap)
+{
+    Extent e;
+
+    for (int i = 0; i < numExtents; i++)
+    {
+        getExtent(i, &e);
+        for (int j = 0; j < e.length; j++) {
+            ASSERT(freeMap->Test(e.start + j)); // ought to be marked!
+            freeMap->Clear(e.start + j);
+        }
+    }
+    numExtents = numSectors = 0;
+    releaseIndex(freeMap);
+}
+
+//----------------------------------------------------------------------
+// FileHeader::Trim
+// 	Give back the sectors past the end of the file, which were
+//	preallocated while it was growing.  Called when the file is
+//	closed for the last time.
+//----------------------------------------------------------------------
+
+void FileHeader::Trim(BitMap *freeMap)
+{
+    int used = divRoundUp(numBytes, SectorSize);
+    Extent e;
+
+    while (numExtents > 0) {
+        getExtent(numExtents - 1, &e);
+        if (e.logical + e.length <= used)
+            break;
+        int keep = (used > e.logical) ? used - e.logical : 0;
+        for (int j = keep; j < e.length; j++)
+            freeMap->Clear(e.start + j);
+        e.length = keep;
+        if (e.length == 0)
+            numExtents--;
+        else
+            putExtent(numExtents - 1, &e, freeMap);
+    }
+    if (numExtents > 0)         // 前面的extent之后可能是空洞
+        numSectors = e.logical + e.length;
+    else
+        numSectors = 0;
+    releaseIndex(freeMap);
+}
+
+//----------------------------------------------------------------------
+// FileHeader::FetchFrom
+// 	Fetch contents of file header from disk.  A header written before
+//	files were made of extents is converted on the way in.  Only the
+//	on-disk part of the object (the first SectorSize bytes) is read;
+//	index blocks cached for a previous header are forgotten.
+//
+//	"sector" is the disk sector containing the file header
+//----------------------------------------------------------------------
+
+void FileHeader::FetchFrom(int sector)
+{
+    ASSERT((char *) &indexCache - (char *) this == SectorSize);
+    flushIndex(TRUE);
+    extentHint = 0;
+    bufferCache->ReadSector(sector, (char *)this);
+    if (magic != FileHeaderMagic)
+        convertLegacy(sector);
+}
+
+//----------------------------------------------------------------------
+// FileHeader::convertLegacy
+// 	The header just read is in the old format, a table of sector
+//	numbers.  Rebuild it as extents, merging sectors that happen to be
+//	consecutive, free the old indirect sector and write the new header
+//	back.  If the old sectors are too scattered to fit in the extent
+//	table, the data is copied to a freshly allocated run instead.
+//----------------------------------------------------------------------
+
+void FileHeader::convertLegacy(int sector)
+{
+    int *old = new int[SectorSize / sizeof(int)];
+    bcopy((char *) this, (char *) old, SectorSize);
+    int oldBytes = old[0], oldSectors = old[1];
+    int *direct = old + 2;
+    int *sectors = new int[oldSectors];
+    int *index = NULL;
+    bool fits = TRUE;
+
+    DEBUG('f', "Converting old file header at sector %d\n", sector);
+    for (int i = 0; i < oldSectors; i++) {
+        if (i < LegacyNumDirect) {
+            sectors[i] = direct[i];
+        } else {
+            if (index == NULL) {
+                index = new int[SectorSize / sizeof(int)];
+                bufferCache->ReadSector(direct[LegacyNumDirect], (char *) index);
+            }
+            sectors[i] = index[i - LegacyNumDirect];
+        }
+    }
+
+    reset();
+    numBytes = oldBytes;
+    for (int i = 0; i < oldSectors && fits; i++)
+        fits = addRun(NULL, sectors[i], 1);
+    if (!fits) {                // 太零散，复制到一段新分配的扇区
+        char *buf = new char[SectorSize];
+        ASSERT(fileSystem != NULL);
+        reset();
+        numBytes = oldBytes;
+        ASSERT(fileSystem->extendFile(this, oldSectors, FALSE));
+        for (int i = 0; i < oldSectors; i++) {
+            bufferCache->ReadSector(sectors[i], buf);
+            bufferCache->WriteSector(ByteToSector(i * SectorSize, NULL), buf);
+            fileSystem->freeSector(sectors[i]);
+        }
+        delete [] buf;
+    }
+    if (index != NULL) {
+        ASSERT(fileSystem != NULL);
+        fileSystem->freeSector(direct[LegacyNumDirect]);
+        delete [] index;
+    }
+    WriteBack(sector);
+    delete [] sectors;
+    delete [] old;
+}
+
+//----------------------------------------------------------------------
+// FileHeader::WriteBack
+// 	Write the modified contents of the file header back to disk,
+//	together with the index blocks changed since the last WriteBack.
+//	All of them go into the current journal transaction.
+//
+//	"sector" is the disk sector to contain the file header
+//----------------------------------------------------------------------
+
+void FileHeader::WriteBack(int sector)
+{
+    flushIndex(FALSE);
+    bufferCache->WriteSector(sector, (char *)this);
+    journal->Log(sector);
+}
+
+//----------------------------------------------------------------------
+// FileHeader::ByteToSector
+// 	Return which disk sector is storing a particular byte within the file.
+//      This is essentially a translation from a virtual address (the
+//	offset in the file) to a physical address (the sector where the
+//	data at the offset is stored).
+//
+//	"offset" is the location within the file of the byte in question
+//  如果offset超出了已经分配的扇区，则通过文件系统为文件分配新的扇区（prealloc
+//  为TRUE时连同预分配的扇区），再在extent表中查找。
+//   传入虚拟文件系统的指针是为了通过文件系统申请新的磁盘块
+//  hdrSector是这个文件头所在的扇区（-1表示不知道），分配时和位图一起记入日志
+//  磁盘（或extent表）满了分配不到扇区时返回-1，由调用者决定怎么处理
+//----------------------------------------------------------------------
+
+int FileHeader::ByteToSector(int offset, FileSystem* filesys, bool prealloc,
+                             int hdrSector)
+{
+    int sector = Lookup(offset);
+
+    if(sector == -1){           // 空洞或超出了文件末尾，写操作会发生
+        ASSERT(filesys != NULL);
+        if(!filesys->fillHole(this, offset / SectorSize, prealloc, hdrSector))
+            return -1;          // 磁盘已满
+        sector = Lookup(offset);
+    }
+    return sector;
+}
+
+//----------------------------------------------------------------------
+// FileHeader::Lookup
+// 	Like ByteToSector, but never allocates: return -1 if the byte at
+//	"offset" is in a hole (or past the allocated part of the file).
+//	Readers use this, so holes cost no disk space and no disk I/O.
+//----------------------------------------------------------------------
+
+int FileHeader::Lookup(int offset)
+{
+    int index = offset / SectorSize;
+    Extent e;
+
+    if (IsInline() || index >= numSectors)
+        return -1;
+    getExtent(findExtent(index), &e);
+    if (index < e.logical || index >= e.logical + e.length)
+        return -1;              // 空洞
+    return e.start + (index - e.logical);
+}
+
+//----------------------------------------------------------------------
+// FileHeader::FileLength
+// 	Return the number of bytes in the file.
+//----------------------------------------------------------------------
+
+int FileHeader::FileLength()
+{
+    return numBytes;
+}
+
+//----------------------------------------------------------------------
+// FileHeader::Print
+// 	Print the contents of the file header, and the contents of all
+//	the data blocks pointed to by the file header.
+//----------------------------------------------------------------------
+
+void FileHeader::Print()
+{
+    int i, j, k;
+    char *data = new char[SectorSize];
+    Extent e;
+
+    printf("FileHeader contents.  File size: %d.  File extents:\n", numBytes);
+    for (i = 0; i < numExtents; i++)
+    {
+        getExtent(i, &e);
+        printf("%d-%d ", e.start, e.start + e.length - 1);
+    }
+    printf("\nFile contents:\n");
+    for (i = k = 0; k < numBytes; i++)
+    {
+        int sector = Lookup(i * SectorSize);
+        if (IsInline())         // 内容在文件头里
+            bcopy(inlineData(), data, InlineSize);
+        else if (sector == -1)  // 空洞
+            bzero(data, SectorSize);
+        else
+            bufferCache->ReadSector(sector, data);
+        for (j = 0; (j < SectorSize) && (k < numBytes); j++, k++)
+        {
+            if ('\040' <= data[j] && data[j] <= '\176') // isprint(data[j])
+                printf("%c", data[j]);
+            else
+                printf("\\%x", (unsigned char)data[j]);
+        }
+        printf("\n");
+    }
+    delete[] data;
+}
+
+bool FileHeader::init(FileSystem* fileSystem) {
+	numBytes = 4;               // 4个0字节：空目录（表项数为0）
+    flags |= HdrInline;         // 不分配数据扇区，第一次写超过InlineSize时再分配
+    bzero(inlineData(), InlineSize);
+    return TRUE;
+}
+
+//----------------------------------------------------------------------
+// FileHeader::ReadInline/WriteInline
+// 	Copy file contents stored in the header itself.  The caller checks
+//	the range: reads stay within the file, writes within InlineSize.
+//	A write past the end makes the file longer; the bytes in between
+//	read as zero.
+//----------------------------------------------------------------------
+
+void FileHeader::ReadInline(char *into, int count, int position)
+{
+    ASSERT(IsInline() && position >= 0 && position + count <= numBytes);
+    bcopy(inlineData() + position, into, count);
+}
+
+void FileHeader::WriteInline(char *from, int count, int position)
+{
+    ASSERT(IsInline() && position >= 0 && position + count <= InlineSize);
+    if (position > numBytes)            // 中间的空洞
+        bzero(inlineData() + numBytes, position - numBytes);
+    bcopy(from, inlineData() + position, count);
+    if (position + count > numBytes)
+        numBytes = position + count;
+}
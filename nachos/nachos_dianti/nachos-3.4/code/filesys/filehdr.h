@@ -1,76 +1,159 @@
-// filehdr.h
-//	Data structures for managing a disk file header.
-//
-//	A file header describes where on disk to find the data in a file,
-//	along with other information about the file (for instance, its
-//	length, owner, etc.)
-//
-// Copyright (c) 1992-1993 The Regents of the University of California.
-// All rights reserved.  See copyright.h for copyright notice and limitation
-// of liability and disclaimer of warranty provisions.
-
-#include "copyright.h"
-
-#ifndef FILEHDR_H
-#define FILEHDR_H
-
-#include "disk.h"
-#include "bitmap.h"
-
-/*
-  采取二级索引的方式，文件索引表的长度为30， 将其前29个块作为一级索引，第30个块作为2级索引
-
-*/
-#define NumIndex ((SectorSize - 2 * sizeof(int)) / sizeof(int))
-#define MaxFileSize ((29 + 32) * SectorSize)
-#define NumDirectIndex (NumIndex - 1)
-#define Num2Index (NumDirectIndex + 32)
-// The following class defines the Nachos "file header" (in UNIX terms,
-// the "i-node"), describing where on disk to find all of the data in the file.
-// The file header is organized as a simple table of pointers to
-// data blocks.
-//
-// The file header data structure can be stored in memory or on disk.
-// When it is on disk, it is stored in a single sector -- this means
-// that we assume the size of this data structure to be the same
-// as one disk sector.  Without indirect addressing, this
-// limits the maximum file length to just under 4K bytes.
-//
-// There is no constructor; rather the file header can be initialized
-// by allocating blocks for the file (if it is a new file), or by
-// reading it from disk.
-class FileSystem;
-
-class FileHeader
-{
-public:
-	FileHeader();
-    bool Allocate(BitMap *bitMap, int fileSize); // Initialize a file header,
-                                                 //  including allocating space
-                                                 //  on disk for the file disk
-    void Deallocate(BitMap *bitMap);             // De-allocate this file's
-                                                 //  data blocks
-
-    void FetchFrom(int sectorNumber); // Initialize file header from disk
-    void WriteBack(int sectorNumber); // Write modifications to file header
-                                      //  back to disk
-
-    int ByteToSector(int offset, FileSystem* filesys); // Convert a byte offset into the file
-                                  // to the disk sector containing
-                                  // the byte
-
-    int FileLength(); // Return the length of the file
-                      // in bytes
-
-    void Print(); // Print the contents of the file.
-    void setFileLength(int len){this->numBytes = len;};
-    bool init(FileSystem* fileSystem);   // 初始化为一个目录文件，需要分配一个磁盘块
-private:
-    int numBytes;              // Number of bytes in the file
-    int numSectors;            // Number of data sectors in the file
-    int dataSectors[NumIndex]; // Disk sector numbers for each data
-                               // block in the file
-friend class Directory;
-};
-
-#endif // FILEHDR_H
+// filehdr.h
+//	Data structures for managing a disk file header.
+//
+//	A file header describes where on disk to find the data in a file,
+//	along with other information about the file (for instance, its
+//	length, owner, etc.)
+//
+// Copyright (c) 1992-1993 The Regents of the University of California.
+// All rights reserved.  See copyright.h for copyright notice and limitation
+// of liability and disclaimer of warranty provisions.
+
+#include "copyright.h"
+
+#ifndef FILEHDR_H
+#define FILEHDR_H
+
+#include "disk.h"
+#include "bitmap.h"
+
+/*
+  文件的数据用extent（连续的扇区段）描述：每个extent记录文件中的起始扇区序号、
+  磁盘上的起始扇区号和长度。文件头里直接存放NumDirectExtents个extent，
+  更多的extent放在extent块中：indirect[0]直接指向一个extent块，indirect[1]
+  是二级索引（指向一个存放extent块扇区号的指针块），indirect[2]是三级索引。
+  分配时优先紧接着文件最后一个extent继续分配，否则在空闲位图中best-fit
+  找一段连续的空闲扇区；文件增长时多预分配一些扇区，最后一次关闭时释放。
+
+  很小的文件（不超过InlineSize字节）不分配数据扇区，内容直接存放在文件头
+  里indirect和extents所占的位置（flags中有HdrInline）。文件变大时内容搬到
+  新分配的第一个数据扇区，文件头变回普通的extent格式。
+
+  文件可以有空洞：extent按文件中的位置排列，但相邻的extent之间可以不连续。
+  没有被任何extent覆盖的扇区读出为0，不占磁盘空间，第一次写时才分配
+  （FileHeader::Fill）。
+*/
+#define FileHeaderMagic 0x45787446 // 区分extent格式的文件头和旧格式的文件头
+#define NumDirectExtents 8
+#define NumIndirect 3           // 一级、二级、三级间接索引
+#define ExtentsPerSector ((int) (SectorSize / sizeof(Extent)))
+#define PointersPerSector ((int) (SectorSize / sizeof(int)))
+#define MaxExtents (NumDirectExtents + ExtentsPerSector * (1 + PointersPerSector \
+                    + PointersPerSector * PointersPerSector))
+#define MinPrealloc 4           // 文件增长时至少多分配的扇区数
+#define MaxPrealloc SectorsPerTrack // 最多多分配的扇区数
+
+#define IndexCacheSize 16       // 每个打开的文件头缓存的间接块数
+
+#define HdrInline 0x1           // flags：文件内容存放在文件头中
+#define InlineSize ((int) (NumIndirect * sizeof(int) + NumDirectExtents * sizeof(Extent)))
+
+// 一段连续的数据扇区
+class Extent {
+  public:
+    int logical;		// 第一个扇区在文件中的序号
+    int start;			// 第一个扇区的磁盘扇区号
+    int length;			// 扇区数
+};
+
+// 文件头缓存在内存中的一个间接块（extent块或指针块）
+class IndexBlock {
+  public:
+    int sector;			// 间接块的扇区号，-1表示空闲
+    bool dirty;			// 修改过，WriteBack时写回
+    int lastUsed;		// 用于LRU替换
+    char data[SectorSize];
+};
+
+// The following class defines the Nachos "file header" (in UNIX terms,
+// the "i-node"), describing where on disk to find all of the data in the file.
+// The file header is organized as a table of extents, each a run of
+// consecutive data sectors, kept in order of their position in the file.
+//
+// The file header data structure can be stored in memory or on disk.
+// When it is on disk, it is stored in a single sector -- this means
+// that we assume the size of this data structure to be the same
+// as one disk sector.
+//
+// There is no constructor; rather the file header can be initialized
+// by allocating blocks for the file (if it is a new file), or by
+// reading it from disk.
+class FileSystem;
+class CachedHeader;
+
+class FileHeader
+{
+public:
+	FileHeader();
+	~FileHeader();
+    bool Allocate(BitMap *bitMap, int fileSize); // Initialize a file header,
+                                                 //  including allocating space
+                                                 //  on disk for the file disk
+    void Deallocate(BitMap *bitMap);             // De-allocate this file's
+                                                 //  data blocks
+    bool Extend(BitMap *bitMap, int sectors, bool prealloc);
+                                                 // 分配数据扇区，直到文件至少有sectors个扇区
+    bool Fill(BitMap *bitMap, int logical, bool prealloc);
+                                                 // 给文件的第logical个扇区（空洞）分配磁盘扇区
+    void Trim(BitMap *bitMap);                   // 释放文件末尾之后预分配的扇区
+
+    void FetchFrom(int sectorNumber); // Initialize file header from disk
+    void WriteBack(int sectorNumber); // Write modifications to file header
+                                      //  back to disk
+
+    int ByteToSector(int offset, FileSystem* filesys, bool prealloc = TRUE,
+                     int hdrSector = -1);
+                                  // Convert a byte offset into the file
+                                  // to the disk sector containing
+                                  // the byte
+    int Lookup(int offset);       // 同上，但不分配扇区，空洞返回-1
+
+    int FileLength(); // Return the length of the file
+                      // in bytes
+
+    void Print(); // Print the contents of the file.
+    void setFileLength(int len){this->numBytes = len;};
+    bool init(FileSystem* fileSystem);   // 初始化一个新文件（内容存放在文件头中）
+
+    bool IsInline() { return (flags & HdrInline) != 0; }
+    int NumExtents() { return numExtents; }
+    bool HasPrealloc() { return numSectors > divRoundUp(numBytes, SectorSize); } // 文件末尾之后有预分配的扇区
+    int IndirectSector(int level) { return indirect[level]; } // 第level级间接块，-1表示没有
+    void ReadInline(char *into, int count, int position);  // 读写存放在文件头中的内容，
+    void WriteInline(char *from, int count, int position); // 写不能超过InlineSize
+private:
+    void getExtent(int i, Extent *e);   // 读第i个extent
+    bool putExtent(int i, Extent *e, BitMap *bitMap); // 写第i个extent，需要时分配间接块
+    int extentBlock(int i, int *slot, BitMap *bitMap); // 第i个extent所在的extent块
+    int newIndexBlock(BitMap *bitMap);  // 分配一个间接块，内容初始化为-1
+    void freeIndex(BitMap *bitMap, int *sector, int level, int first);
+    void releaseIndex(BitMap *bitMap);  // 释放numExtents之后不再需要的间接块
+    IndexBlock *loadIndex(int sector, bool fill); // 缓存中的间接块，需要时读入
+    void dropIndex(int sector);         // 从缓存中去掉（块被释放了）
+    void flushIndex(bool forget);       // 写回修改过的间接块
+    void reset();                       // 变成一个空文件
+    int findExtent(int logical);        // 文件第logical个扇区所在（或之前）的extent
+    void insertExtent(int i, Extent *e, BitMap *bitMap); // 在第i个位置插入一个extent
+    bool addRun(BitMap *bitMap, int start, int length); // 在文件末尾加一段扇区
+    void convertLegacy(int sector);     // 把旧格式的文件头转换成extent格式
+    char *inlineData() { return (char *) indirect; }
+
+    int magic;                 // FileHeaderMagic
+    int numBytes;              // Number of bytes in the file
+    int numSectors;            // 最后一个extent结束处在文件中的扇区序号，
+                               // 包括预分配的扇区（有空洞时大于实际分配的扇区数）
+    int numExtents;            // Number of extents in use
+    int flags;                 // HdrInline
+    int indirect[NumIndirect]; // 一级、二级、三级间接块，-1表示没有
+    Extent extents[NumDirectExtents];
+
+    // 以下只在内存中，不写到磁盘上（FetchFrom/WriteBack只读写前SectorSize字节）
+    IndexBlock *indexCache;    // 已经读入的间接块，第一次用到时分配
+    int indexClock;            // 间接块的访问计数
+    int extentHint;            // 上一次找到的extent
+    CachedHeader *cached;      // 在headerCache中的表项，不在缓存中为NULL
+friend class Directory;
+friend class HeaderCache;
+};
+
+#endif // FILEHDR_H
@@ -1,459 +1,731 @@
-// filesys.cc
-//	Routines to manage the overall operation of the file system.
-//	Implements routines to map from textual file names to files.
-//
-//	Each file in the file system has:
-//	   A file header, stored in a sector on disk
-//		(the size of the file header data structure is arranged
-//		to be precisely the size of 1 disk sector)
-//	   A number of data blocks
-//	   An entry in the file system directory
-//
-// 	The file system consists of several data structures:
-//	   A bitmap of free disk sectors (cf. bitmap.h)
-//	   A directory of file names and file headers
-//
-//      Both the bitmap and the directory are represented as normal
-//	files.  Their file headers are located in specific sectors
-//	(sector 0 and sector 1), so that the file system can find them
-//	on bootup.
-//
-//	The file system assumes that the bitmap and directory files are
-//	kept "open" continuously while Nachos is running.
-//
-//	For those operations (such as Create, Remove) that modify the
-//	directory and/or bitmap, if the operation succeeds, the changes
-//	are written immediately back to disk (the two files are kept
-//	open during all this time).  If the operation fails, and we have
-//	modified part of the directory and/or bitmap, we simply discard
-//	the changed version, without writing it back to disk.
-//
-// 	Our implementation at this point has the following restrictions:
-//
-//	   there is no synchronization for concurrent accesses
-//	   files have a fixed size, set when the file is created
-//	   files cannot be bigger than about 3KB in size
-//	   there is no hierarchical directory structure, and only a limited
-//	     number of files can be added to the system
-//	   there is no attempt to make the system robust to failures
-//	    (if Nachos exits in the middle of an operation that modifies
-//	    the file system, it may corrupt the disk)
-//
-// Copyright (c) 1992-1993 The Regents of the University of California.
-// All rights reserved.  See copyright.h for copyright notice and limitation
-// of liability and disclaimer of warranty provisions.
-
-#include "copyright.h"
-
-#include "disk.h"
-#include "bitmap.h"
-#include "directory.h"
-#include "filehdr.h"
-#include "filesys.h"
-
-// Sectors containing the file headers for the bitmap of free sectors,
-// and the directory of files.  These file headers are placed in well-known
-// sectors, so that they can be located on boot-up.
-#define FreeMapSector 0
-#define RootDirectorySector 1
-#define FreeMapDataSector 2
-// Initial file sizes for the bitmap and directory; until the file system
-// supports extensible files, the directory size sets the maximum number
-// of files that can be loaded onto the disk.
-#define FreeMapFileSize (NumSectors / BitsInByte)
-#define NumDirEntries 10
-#define DirectoryFileSize (sizeof(DirectoryEntry) * NumDirEntries)
-
-//----------------------------------------------------------------------
-// FileSystem::FileSystem
-// 	Initialize the file system.  If format = TRUE, the disk has
-//	nothing on it, and we need to initialize the disk to contain
-//	an empty directory, and a bitmap of free sectors (with almost but
-//	not all of the sectors marked as free).
-//
-//	If format = FALSE, we just have to open the files
-//	representing the bitmap and the directory.
-//
-//	"format" -- should we initialize the disk?
-//----------------------------------------------------------------------
-
-FileSystem::FileSystem(bool format) {
-	DEBUG('f', "Initializing the file system.\n");
-	if (format) {
-		DEBUG('f', "Formatting the file system.\n");
-		BitMap *freeMap = new BitMap(NumSectors);
-		FileHeader *mapHdr = new FileHeader;
-
-		/*  标记空闲数据块的文件头的磁盘块号 */
-		freeMap->Mark(FreeMapSector);
-		freeMap->Mark(RootDirectorySector); // 标记根目录文件头数据块
-
-		/*  给空闲位图分配文件数据块*/
-		ASSERT(mapHdr->Allocate(freeMap, FreeMapFileSize));
-
-		/*  将空闲位图head写回磁盘 */
-		mapHdr->WriteBack(FreeMapSector);
-
-		/*  将空闲位图以文件形式打开  */
-		freeMapFile = new OpenFile(FreeMapSector);
-		freeMapFile->filesys = this;
-
-		freeMap->WriteBack(freeMapFile);
-		/*  创建根目录 */
-		Directory *root = new Directory();
-		FileHeader *rootDirHdr = new FileHeader;
-		ASSERT(rootDirHdr->init(this));
-
-		/*  将根目录文件头写回指定位置 */
-		rootDirHdr->WriteBack(RootDirectorySector);
-
-		/*  将根目录以文件形式打开 */
-		rootDirectoryFile = new OpenFile(RootDirectorySector);
-		rootDirectoryFile->filesys = this;
-
-		if (DebugIsEnabled('f')) {
-			freeMap->Print();
-			root->Print();
-
-			delete freeMap;
-			delete root;
-			delete mapHdr;
-			delete rootDirHdr;
-		}
-	} else {
-		// if we are not formatting the disk, just open the files representing
-		// the bitmap and directory; these are left open while Nachos is running
-		freeMapFile = new OpenFile(FreeMapSector);
-		rootDirectoryFile = new OpenFile(RootDirectorySector);
-	}
-	fileTable = new OpenFileTable[ALL_FILE_TABLE_SIZE];
-}
-
-//----------------------------------------------------------------------
-// FileSystem::Create
-// 	Create a file in the Nachos file system (similar to UNIX create).
-//	Since we can't increase the size of files dynamically, we have
-//	to give Create the initial size of the file.
-//
-//	The steps to create a file are:
-//	  Make sure the file doesn't already exist
-//        Allocate a sector for the file header
-// 	  Allocate space on disk for the data blocks for the file
-//	  Add the name to the directory
-//	  Store the new file header on disk
-//	  Flush the changes to the bitmap and the directory back to disk
-//
-//	Return TRUE if everything goes ok, otherwise, return FALSE.
-//
-// 	Create fails if:
-//   		file is already in directory
-//	 	no free space for file header
-//	 	no free entry for file in directory
-//	 	no free space for data blocks for the file
-//
-// 	Note that this implementation assumes there is no concurrent access
-//	to the file system!
-//
-//	"name" -- name of file to be created
-//	"initialSize" -- size of file to be created
-//----------------------------------------------------------------------
-
-bool FileSystem::Create(char *name, int initialSize, bool isFile) {
-	int sector;
-	bool success;
-
-	DEBUG('f', "Creating dir %s\n", name);
-
-	int fatherSec = findFatherDirectory(name, RootDirectorySector);
-	OpenFile *fatherFile = new OpenFile(fatherSec);
-	fatherFile->filesys = this;
-	Directory *fatherDir = new Directory();
-	fatherDir->FetchFrom(fatherFile);
-
-	if (fatherDir->Find(name) != -1) {
-		success = FALSE; // file is already in directory
-	} else {
-		sector = findEmptySector();
-		if (sector == -1)
-			success = FALSE; // no free block for file header
-		else {
-			fatherDir->Add(getFileName(name), sector, this, isFile, fatherFile->hdr);
-			FileHeader *hdr = new FileHeader;
-			hdr->init(this);
-			hdr->WriteBack(sector);
-			fatherDir->WriteBack(fatherFile);
-			fatherFile->hdr->WriteBack(fatherSec);
-			success = TRUE;
-			delete hdr;
-		}
-	}
-	return success;
-}
-
-//----------------------------------------------------------------------
-// FileSystem::Open
-// 	Open a file for reading and writing.
-//	To open a file:
-//	  Find the location of the file's header, using the directory
-//	  Bring the header into memory
-//
-//	"name" -- the text name of the file to be opened
-// 对应线程管理，修改打开文件的方式，搜索当前是否已经打开了文件
-//----------------------------------------------------------------------
-
-OpenFile *
-FileSystem::Open(char *name) {
-
-	Directory *directory = new Directory(
-			findFatherDirectory(name, RootDirectorySector));
-	OpenFile *openFile = 0;
-	int sector;
-	DEBUG('f', "Opening file %s\n", name);
-	sector = directory->Find(getFileName(name));
-	if (sector >= 0) {
-		int index = openFileIndex(sector);
-		if (index == -1) {
-			FileHeader *hdr = addFile2OpenTable(sector, directory);
-			ASSERT(hdr != 0);		  // 最多打开1024文件
-			openFile = new OpenFile(hdr); // name was found in directory
-		} else {
-			fileTable[index].openCount++;
-			openFile = new OpenFile(fileTable[index].fileHdr);
-			delete directory;
-		}
-	}
-	openFile->filesys = this;
-	return openFile; // return NULL if not found
-}
-/*
- 某个线程关闭打开的文件
- */
-void FileSystem::Close(OpenFile *openFile) {
-	/*
-	 处理线程结构体中的数据
-	 */
-
-	/*
-	 处理总数据
-	 */
-	for (int i = 0; i < ALL_FILE_TABLE_SIZE; i++) {
-		if (fileTable[i].fileHdr == openFile->hdr) {
-			fileTable[i].openCount--;
-			if (fileTable[i].openCount == 0) {
-				delete fileTable[i].fileHdr;
-				delete fileTable[i].father;
-				if (fileTable[i].toRemove == TRUE)
-					deleteFile(fileTable[i].headSec, fileTable[i].father);
-				fileTable[i].headSec = -1;
-			}
-			break;
-		}
-	}
-}
-//----------------------------------------------------------------------
-// FileSystem::Remove
-// 	Delete a file from the file system.  This requires:
-//	    Remove it from the directory
-//	    Delete the space for its header
-//	    Delete the space for its data blocks
-//	    Write changes to directory, bitmap back to disk
-//
-//	Return TRUE if the file was deleted, FALSE if the file wasn't
-//	in the file system.
-//
-//	"name" -- the text name of the file to be removed
-//----------------------------------------------------------------------
-
-bool FileSystem::Remove(char *name) {
-	Directory *directory;
-	BitMap *freeMap;
-	FileHeader *fileHdr;
-	int sector;
-
-	directory = new Directory(findFatherDirectory(name, RootDirectorySector));
-	sector = directory->Find(name);
-	if (sector == -1) {
-		delete directory;
-		return FALSE; // file not found
-	}
-	int index = openFileIndex(sector);
-	if (index != -1) { // 文件正在打开
-		fileTable[index].toRemove = TRUE;
-		return TRUE;
-	}
-	return deleteFile(sector, fileTable[index].father);
-}
-
-bool FileSystem::deleteFile(int sec, Directory* directory) {
-	FileHeader *fileHdr = new FileHeader;
-	fileHdr->FetchFrom(sec);
-
-	BitMap *freeMap = new BitMap(NumSectors);
-	freeMap->FetchFrom(freeMapFile);
-
-	fileHdr->Deallocate(freeMap); // remove data blocks
-	freeMap->Clear(sec);		  // remove header block
-	directory->Remove(sec);
-
-	freeMap->WriteBack(freeMapFile);		 // flush to disk
-	directory->WriteBack(rootDirectoryFile); // flush to disk
-	delete fileHdr;
-	delete freeMap;
-	return TRUE;
-}
-
-//----------------------------------------------------------------------
-// FileSystem::List
-// 	List all the files in the file system directory.
-//----------------------------------------------------------------------
-
-void FileSystem::List() {
-	Directory *directory = new Directory();
-
-	directory->FetchFrom(rootDirectoryFile);
-	directory->List();
-	delete directory;
-}
-
-//----------------------------------------------------------------------
-// FileSystem::Print
-// 	Print everything about the file system:
-//	  the contents of the bitmap
-//	  the contents of the directory
-//	  for each file in the directory,
-//	      the contents of the file header
-//	      the data in the file
-//----------------------------------------------------------------------
-
-void FileSystem::Print() {
-	FileHeader *bitHdr = new FileHeader;
-	FileHeader *dirHdr = new FileHeader;
-	BitMap *freeMap = new BitMap(NumSectors);
-	Directory *directory = new Directory();
-
-	printf("Bit map file header:\n");
-	bitHdr->FetchFrom(FreeMapSector);
-	bitHdr->Print();
-
-	printf("Directory file header:\n");
-	dirHdr->FetchFrom(RootDirectorySector);
-	dirHdr->Print();
-
-	freeMap->FetchFrom(freeMapFile);
-	freeMap->Print();
-
-	directory->FetchFrom(rootDirectoryFile);
-	directory->Print();
-
-	delete bitHdr;
-	delete dirHdr;
-	delete freeMap;
-	delete directory;
-}
-
-/*
- 查找分配空闲磁盘块
- */
-int FileSystem::findEmptySector() {
-	BitMap *freeMap = new BitMap(NumSectors);
-	freeMap->FetchFrom(freeMapFile);
-	int sec = freeMap->Find();
-	freeMap->WriteBack(freeMapFile);
-	return sec;
-}
-
-/*
- 分割文件名称， 获得其所属文件夹
- */
-
-int FileSystem::findFatherDirectory(char *name, int pwdSec) {
-	char *tmp = name;
-	if (*tmp == '/') {
-		tmp++;
-		name++;
-	}
-	int len = 0;
-	while (*tmp != '\0' && tmp != 0 && *tmp != '/') {
-		len++;
-		tmp++;
-	}
-	char *fileName = new char[len + 1];
-	memcpy(fileName, name, len);
-	fileName[len] = '\0';
-	if (tmp == 0 || *tmp == '\0') { // 文件
-		return pwdSec;
-	} else { // 文件夹
-		Directory *pwd = new Directory(pwdSec);
-		int childSec = pwd->Find(fileName);
-		if (childSec == -1)
-			return -1;
-		return findFatherDirectory(tmp, childSec);
-	}
-}
-
-char *FileSystem::getFileName(char *abName) {
-	int lastSep = -1;
-	int i = 0;
-	char *tmp = abName;
-	for (int j = strlen(abName) - 1; j >= 0; j--) {
-		if (abName[j] == '/') {
-			lastSep = j;
-			break;
-		}
-	}
-	if (lastSep == -1)
-		return abName;
-	return abName + lastSep + 1;
-}
-
-int FileSystem::openFileIndex(int sec) {
-	for (int i = 0; i < ALL_FILE_TABLE_SIZE; i++) {
-		if (fileTable[i].headSec == sec)
-			return i;
-	}
-	return -1;
-}
-int FileSystem::openFileIndex(OpenFile *file) {
-	for (int i = 0; i < ALL_FILE_TABLE_SIZE; i++) {
-		if (fileTable[i].fileHdr == file->hdr)
-			return i;
-	}
-	return -1;
-}
-FileHeader *FileSystem::addFile2OpenTable(int sec, Directory* father) {
-	int index = -1;
-	for (int i = 0; i < ALL_FILE_TABLE_SIZE; i++) {
-		if (fileTable[i].headSec == -1) {
-			index = i;
-			break;
-		}
-	}
-	if (index == -1)
-		return 0;
-	FileHeader *hdr = new FileHeader();
-	hdr->FetchFrom(sec);
-	fileTable[index].fileHdr = hdr;
-	fileTable[index].headSec = sec;
-	fileTable[index].openCount = 1;
-	fileTable[index].father = father;
-	return hdr;
-}
-
-int FileSystem::fread(OpenFile *file, char *into, int numBytes) {
-	int index = openFileIndex(file);
-	if (index == -1)
-		return -1;
-	fileTable[index].lock->prepareRead();
-	int count = file->Read(into, numBytes);
-	fileTable[index].lock->doneRead();
-	return count;
-}
-int FileSystem::fwrite(OpenFile *file, char *into, int numBytes) {
-	int index = openFileIndex(file);
-	if (index == -1)
-		return -1;
-	fileTable[index].lock->prepareWrite();
-	int count = file->Write(into, numBytes);
-	fileTable[index].lock->doneWrite();
-	return count;
-}
+// filesys.cc
+//	Routines to manage the overall operation of the file system.
+//	Implements routines to map from textual file names to files.
+//
+//	Each file in the file system has:
+//	   A file header, stored in a sector on disk
+//		(the size of the file header data structure is arranged
+//		to be precisely the size of 1 disk sector)
+//	   A number of data blocks
+//	   An entry in the file system directory
+//
+// 	The file system consists of several data structures:
+//	   A bitmap of free disk sectors (cf. bitmap.h)
+//	   A directory of file names and file headers
+//
+//      Both the bitmap and the directory are represented as normal
+//	files.  Their file headers are located in specific sectors
+//	(sector 0 and sector 1), so that the file system can find them
+//	on bootup.
+//
+//	The file system assumes that the bitmap and directory files are
+//	kept "open" continuously while Nachos is running.
+//
+//	For those operations (such as Create, Remove) that modify the
+//	directory and/or bitmap, if the operation succeeds, the changes
+//	are written immediately back to disk (the two files are kept
+//	open during all this time).  If the operation fails, and we have
+//	modified part of the directory and/or bitmap, we simply discard
+//	the changed version, without writing it back to disk.
+//
+// 	Our implementation at this point has the following restrictions:
+//
+//	   there is no synchronization for concurrent accesses
+//	   files have a fixed size, set when the file is created
+//	   files cannot be bigger than about 3KB in size
+//	   there is no hierarchical directory structure, and only a limited
+//	     number of files can be added to the system
+//	   there is no attempt to make the system robust to failures
+//	    (if Nachos exits in the middle of an operation that modifies
+//	    the file system, it may corrupt the disk)
+//
+// Copyright (c) 1992-1993 The Regents of the University of California.
+// All rights reserved.  See copyright.h for copyright notice and limitation
+// of liability and disclaimer of warranty provisions.
+
+#include "copyright.h"
+
+#include "disk.h"
+#include "bitmap.h"
+#include "directory.h"
+#include "filehdr.h"
+#include "filesys.h"
+#include "system.h"
+
+// Initial file sizes for the bitmap and directory; until the file system
+// supports extensible files, the directory size sets the maximum number
+// of files that can be loaded onto the disk.
+#define FreeMapFileSize (NumSectors / BitsInByte)
+// 日志超级块放在空闲位图文件中位图之后的那个扇区
+#define JournalSuperOffset (divRoundUp(FreeMapFileSize, SectorSize) * SectorSize)
+#define NumDirEntries 10
+#define DirectoryFileSize (sizeof(DirectoryEntry) * NumDirEntries)
+
+//----------------------------------------------------------------------
+// FileSystem::FileSystem
+// 	Initialize the file system.  If format = TRUE, the disk has
+//	nothing on it, and we need to initialize the disk to contain
+//	an empty directory, and a bitmap of free sectors (with almost but
+//	not all of the sectors marked as free).
+//
+//	If format = FALSE, we just have to open the files
+//	representing the bitmap and the directory.
+//
+//	"format" -- should we initialize the disk?
+//----------------------------------------------------------------------
+
+FileSystem::FileSystem(bool format) {
+	DEBUG('f', "Initializing the file system.\n");
+	if (format) {
+		DEBUG('f', "Formatting the file system.\n");
+		freeMap = new BitMap(NumSectors);
+		freeMap->MarkZeroOnDisk();	// 磁盘是新建的，只写有扇区被分配的部分
+		FileHeader *mapHdr = headerCache->Get(FreeMapSector, FALSE);
+
+		/*  标记空闲数据块的文件头的磁盘块号 */
+		freeMap->Mark(FreeMapSector);
+		freeMap->Mark(RootDirectorySector); // 标记根目录文件头数据块
+
+		/*  给空闲位图分配文件数据块，最后一个扇区是日志超级块*/
+		ASSERT(mapHdr->Allocate(freeMap, JournalSuperOffset + SectorSize));
+
+		/*  将空闲位图head写回磁盘 */
+		mapHdr->WriteBack(FreeMapSector);
+
+		/*  将空闲位图以文件形式打开  */
+		freeMapFile = new OpenFile(FreeMapSector);
+		freeMapFile->filesys = this;
+
+		freeMap->WriteBack(freeMapFile);
+		/*  创建根目录 */
+		Directory *root = new Directory();
+		FileHeader *rootDirHdr = headerCache->Get(RootDirectorySector, FALSE);
+		ASSERT(rootDirHdr->init(this));
+
+		/*  将根目录文件头写回指定位置 */
+		rootDirHdr->WriteBack(RootDirectorySector);
+
+		/*  将根目录以文件形式打开 */
+		rootDirectoryFile = new OpenFile(RootDirectorySector);
+		rootDirectoryFile->filesys = this;
+
+		if (DebugIsEnabled('f')) {
+			freeMap->Print();
+			root->Print();
+		}
+		delete root;
+		headerCache->Release(mapHdr, FALSE);
+		headerCache->Release(rootDirHdr, FALSE);
+		createJournal();
+	} else {
+		// if we are not formatting the disk, just open the files representing
+		// the bitmap and directory; these are left open while Nachos is running
+		freeMapFile = new OpenFile(FreeMapSector);
+		freeMapFile->filesys = this;
+		freeMapFile->journaled = TRUE;
+		// 先重放日志，再读其他元数据（空闲位图文件头不会被日志修改）
+		bool hasJournal = freeMapFile->Length() >= JournalSuperOffset + SectorSize
+			&& journal->Recover(freeMapFile->hdr->ByteToSector(JournalSuperOffset, this));
+		rootDirectoryFile = new OpenFile(RootDirectorySector);
+		rootDirectoryFile->filesys = this;
+		freeMap = new BitMap(NumSectors);	// 读入后一直留在内存中
+		freeMap->FetchFrom(freeMapFile);
+		if (!hasJournal) {	// 没有日志的旧磁盘：给位图文件加上超级块，建立日志
+			ASSERT(extendFile(freeMapFile->hdr,
+					divRoundUp(JournalSuperOffset + SectorSize, SectorSize), FALSE));
+			freeMapFile->hdr->setFileLength(JournalSuperOffset + SectorSize);
+			freeMapFile->hdr->WriteBack(FreeMapSector);
+			createJournal();
+			bufferCache->Flush();
+		}
+	}
+	fileTable = new OpenFileTable[ALL_FILE_TABLE_SIZE];
+	fileBuckets = new int[FILE_TABLE_BUCKETS];
+	for (int i = 0; i < FILE_TABLE_BUCKETS; i++)
+		fileBuckets[i] = -1;
+	for (int i = 0; i < ALL_FILE_TABLE_SIZE; i++)	// 所有表项都空闲
+		fileTable[i].next = (i + 1 < ALL_FILE_TABLE_SIZE) ? i + 1 : -1;
+	freeEntry = 0;
+	nameCache = new NameCache(NameCacheSize);
+}
+
+//----------------------------------------------------------------------
+// FileSystem::createJournal
+// 	Allocate the journal area, as one run of free sectors, and write an
+//	empty journal to it.  The superblock goes in the sector reserved
+//	for it at the end of the bitmap file.  If the disk is too full for
+//	a useful journal, the file system runs without one.
+//----------------------------------------------------------------------
+
+void FileSystem::createJournal() {
+	int got;
+	int start = freeMap->FindRun(JournalSize, &got);
+	if (start == -1 || got < JournalSize / 4) {
+		if (start != -1)
+			for (int i = 0; i < got; i++)
+				freeMap->Clear(start + i);
+		printf("No room for the journal, running without it.\n");
+		return;
+	}
+	freeMap->WriteBack(freeMapFile);
+	journal->Format(freeMapFile->hdr->ByteToSector(JournalSuperOffset, this),
+			start, got);
+	freeMapFile->journaled = TRUE;
+}
+
+//----------------------------------------------------------------------
+// FileSystem::Create
+// 	Create a file in the Nachos file system (similar to UNIX create).
+//	Since we can't increase the size of files dynamically, we have
+//	to give Create the initial size of the file.
+//
+//	The steps to create a file are:
+//	  Make sure the file doesn't already exist
+//        Allocate a sector for the file header
+// 	  Allocate space on disk for the data blocks for the file
+//	  Add the name to the directory
+//	  Store the new file header on disk
+//	  Flush the changes to the bitmap and the directory back to disk
+//
+//	Return TRUE if everything goes ok, otherwise, return FALSE.
+//
+// 	Create fails if:
+//   		file is already in directory
+//	 	no free space for file header
+//	 	no free entry for file in directory
+//	 	no free space for data blocks for the file
+//
+// 	Note that this implementation assumes there is no concurrent access
+//	to the file system!
+//
+//	"name" -- name of file to be created
+//	"initialSize" -- size of file to be created
+//	新文件是空的，initialSize只用来预先分配连续的扇区
+//----------------------------------------------------------------------
+
+bool FileSystem::Create(char *name, int initialSize, bool isFile) {
+	int sector;
+	bool success;
+
+	DEBUG('f', "Creating dir %s\n", name);
+
+	journal->Begin();
+	int fatherSec = findFatherDirectory(name, RootDirectorySector);
+
+	if (fatherSec == -1 || lookup(fatherSec, getFileName(name)) != -1) {
+		success = FALSE; // file is already in directory
+	} else {
+		sector = findEmptySector();
+		if (sector == -1)
+			success = FALSE; // no free block for file header
+		else {
+			OpenFile *fatherFile = new OpenFile(fatherSec);
+			fatherFile->filesys = this;
+			Directory *fatherDir = new Directory();
+			fatherDir->FetchFrom(fatherFile);
+			if (!fatherDir->Add(getFileName(name), sector, this, isFile)) {
+				freeMap->Clear(sector); // 目录满了
+				freeMap->WriteBack(freeMapFile);
+				delete fatherDir;
+				delete fatherFile;
+				journal->End();
+				return FALSE;
+			}
+			nameCache->Enter(fatherSec, getFileName(name), sector);
+			FileHeader *hdr = headerCache->Get(sector, FALSE);
+			hdr->init(this);
+			if (isFile && initialSize > InlineSize) {	// 预留连续的扇区，最后一次关闭时释放没写到的
+				if (!hdr->Extend(freeMap, divRoundUp(initialSize, SectorSize), FALSE)) {
+					// 磁盘满了：释放已经分到的扇区和文件头扇区，删除目录项
+					hdr->Deallocate(freeMap);
+					freeMap->Clear(sector);
+					freeMap->WriteBack(freeMapFile);
+					headerCache->Discard(hdr);
+					fatherDir->Remove(getFileName(name));
+					nameCache->Purge(sector);
+					fatherDir->WriteBack(fatherFile);
+					if (fatherFile->hdrDirty)
+						fatherFile->hdr->WriteBack(fatherSec);
+					delete fatherDir;
+					delete fatherFile;
+					journal->End();
+					return FALSE;
+				}
+				freeMap->WriteBack(freeMapFile);
+			}
+			hdr->WriteBack(sector);		// 和目录项在同一个事务里
+			headerCache->Release(hdr, FALSE);
+			fatherDir->WriteBack(fatherFile);
+			if (fatherFile->hdrDirty)	// 目录文件变长了
+				fatherFile->hdr->WriteBack(fatherSec);
+			success = TRUE;
+			delete fatherDir;
+			delete fatherFile;
+		}
+	}
+	journal->End();
+	return success;
+}
+
+//----------------------------------------------------------------------
+// FileSystem::Open
+// 	Open a file for reading and writing.
+//	To open a file:
+//	  Find the location of the file's header, using the directory
+//	  Bring the header into memory
+//
+//	"name" -- the text name of the file to be opened
+// 对应线程管理，修改打开文件的方式，搜索当前是否已经打开了文件
+//----------------------------------------------------------------------
+
+OpenFile *
+FileSystem::Open(char *name) {
+
+	int fatherSec = findFatherDirectory(name, RootDirectorySector);
+	OpenFile *openFile = 0;
+	int sector = -1;
+	DEBUG('f', "Opening file %s\n", name);
+	if (fatherSec != -1)
+		sector = lookup(fatherSec, getFileName(name));
+	if (sector >= 0) {
+		OpenFileTable *entry;
+		int index = openFileIndex(sector);
+		if (index == -1) {
+			entry = addFile2OpenTable(sector, new Directory(fatherSec),
+					getFileName(name));
+			ASSERT(entry != 0);		  // 最多打开1024文件
+		} else {
+			entry = &fileTable[index];
+			entry->openCount++;
+		}
+		openFile = new OpenFile(entry->fileHdr); // name was found in directory
+		openFile->filesys = this;
+		openFile->entry = entry;
+	}
+	return openFile; // return NULL if not found
+}
+/*
+ 某个线程关闭打开的文件，表项的引用计数在OpenFile的析构函数中处理
+ */
+void FileSystem::Close(OpenFile *openFile) {
+	delete openFile;
+}
+
+//----------------------------------------------------------------------
+// FileSystem::Dup
+// 	复制一个打开文件（Fork/Exec继承文件描述符时使用）。新的OpenFile
+//	有自己的读写位置，初始值与原文件相同，文件头、锁和引用计数共享
+//	系统打开文件表中的同一个表项。
+//----------------------------------------------------------------------
+
+OpenFile *FileSystem::Dup(OpenFile *file) {
+	ASSERT(file->entry != 0);
+	OpenFile *copy = new OpenFile(file->hdr);
+	copy->filesys = this;
+	copy->entry = file->entry;
+	copy->seekPosition = file->seekPosition;
+	copy->entry->openCount++;
+	return copy;
+}
+
+void FileSystem::releaseEntry(OpenFileTable *entry) {
+	entry->openCount--;
+	if (entry->openCount == 0) {
+		// 最后一次关闭：文件被写过（或Create预留的扇区一直没用）时释放预分配的扇区，
+		// 写回文件头（长度和extent可能都变了）；只读过的文件不写任何东西
+		bool trim = entry->hdrDirty || entry->fileHdr->HasPrealloc();
+		if (trim || entry->toRemove)
+			journal->Begin();
+		if (trim) {
+			entry->fileHdr->Trim(freeMap);
+			freeMap->WriteBack(freeMapFile);
+			entry->fileHdr->WriteBack(entry->headSec);
+		}
+		headerCache->Release(entry->fileHdr, FALSE);
+		if (entry->toRemove == TRUE)
+			deleteFile(entry->headSec, entry->father, entry->name);
+		if (trim || entry->toRemove)
+			journal->End();
+		delete entry->father;
+
+		// 从散列表中摘下，放回空闲链表
+		int index = entry - fileTable;
+		int *p = &fileBuckets[entry->headSec % FILE_TABLE_BUCKETS];
+		while (*p != index)
+			p = &fileTable[*p].next;
+		*p = entry->next;
+		entry->next = freeEntry;
+		freeEntry = index;
+
+		entry->fileHdr = 0;
+		entry->father = 0;
+		entry->toRemove = FALSE;
+		entry->hdrDirty = FALSE;
+		entry->headSec = -1;
+	}
+}
+//----------------------------------------------------------------------
+// FileSystem::Remove
+// 	Delete a file from the file system.  This requires:
+//	    Remove it from the directory
+//	    Delete the space for its header
+//	    Delete the space for its data blocks
+//	    Write changes to directory, bitmap back to disk
+//
+//	Return TRUE if the file was deleted, FALSE if the file wasn't
+//	in the file system.
+//
+//	"name" -- the text name of the file to be removed
+//----------------------------------------------------------------------
+
+bool FileSystem::Remove(char *name) {
+	Directory *directory;
+	FileHeader *fileHdr;
+	int sector;
+
+	int fatherSec = findFatherDirectory(name, RootDirectorySector);
+	if (fatherSec == -1)
+		return FALSE;
+	sector = lookup(fatherSec, getFileName(name));
+	if (sector == -1)
+		return FALSE; // file not found
+	int index = openFileIndex(sector);
+	if (index != -1) { // 文件正在打开，最后一次关闭时再删除
+		fileTable[index].toRemove = TRUE;
+		return TRUE;
+	}
+	directory = new Directory(fatherSec);
+	journal->Begin();
+	bool success = deleteFile(sector, directory, getFileName(name));
+	journal->End();
+	delete directory;
+	return success;
+}
+
+bool FileSystem::deleteFile(int sec, Directory* directory, char *name) {
+	FileHeader *fileHdr = headerCache->Get(sec);
+
+	fileHdr->Deallocate(freeMap); // remove data blocks
+	freeMap->Clear(sec);		  // remove header block
+	directory->Remove(name);
+	nameCache->Purge(sec);
+
+	freeMap->WriteBack(freeMapFile);		 // flush to disk
+	directory->WriteBack();				 // flush to disk
+	headerCache->Discard(fileHdr);
+	return TRUE;
+}
+
+//----------------------------------------------------------------------
+// FileSystem::List
+// 	List all the files in the file system directory.
+//----------------------------------------------------------------------
+
+void FileSystem::List() {
+	Directory *directory = new Directory(RootDirectorySector);
+
+	directory->List();
+	delete directory;
+}
+
+//----------------------------------------------------------------------
+// FileSystem::Print
+// 	Print everything about the file system:
+//	  the contents of the bitmap
+//	  the contents of the directory
+//	  for each file in the directory,
+//	      the contents of the file header
+//	      the data in the file
+//----------------------------------------------------------------------
+
+void FileSystem::Print() {
+	FileHeader *bitHdr = headerCache->Get(FreeMapSector);
+	FileHeader *dirHdr = headerCache->Get(RootDirectorySector);
+	Directory *directory = new Directory(RootDirectorySector);
+
+	printf("Bit map file header:\n");
+	bitHdr->Print();
+
+	printf("Directory file header:\n");
+	dirHdr->Print();
+
+	freeMap->Print();
+
+	directory->Print();
+
+	printf("Name cache: %d hits, %d misses\n", nameCache->numHits,
+			nameCache->numMisses);
+	printf("Header cache: %d hits, %d misses\n", headerCache->numHits,
+			headerCache->numMisses);
+	printf("Journal: %d commits, %d sectors logged\n", journal->numCommits,
+			journal->numLogged);
+
+	headerCache->Release(bitHdr, FALSE);
+	headerCache->Release(dirHdr, FALSE);
+	delete directory;
+}
+
+/*
+ 查找分配空闲磁盘块
+ 位图常驻内存，分配时只把改动的那个位图扇区写回（写入缓存，由缓存延迟写盘）
+ */
+int FileSystem::findEmptySector() {
+	int sec = freeMap->Find();
+	if (sec != -1)
+		freeMap->WriteBack(freeMapFile);
+	return sec;
+}
+
+/*
+ 按extent为文件分配连续的数据扇区，prealloc表示多预分配一些（见FileHeader::Extend）。
+ 文件头在hdrSector时，新的extent和位图记入同一个事务：否则在两者之间崩溃，
+ 重放后位图中的扇区已经分配，却没有文件头指向它们
+ */
+bool FileSystem::extendFile(FileHeader *hdr, int numSectors, bool prealloc, int hdrSector) {
+	journal->Begin();
+	bool success = hdr->Extend(freeMap, numSectors, prealloc);
+	freeMap->WriteBack(freeMapFile);
+	if (hdrSector != -1)
+		hdr->WriteBack(hdrSector);
+	journal->End();
+	return success;
+}
+
+bool FileSystem::fillHole(FileHeader *hdr, int logical, bool prealloc, int hdrSector) {
+	journal->Begin();
+	bool success = hdr->Fill(freeMap, logical, prealloc);
+	freeMap->WriteBack(freeMapFile);
+	if (hdrSector != -1)
+		hdr->WriteBack(hdrSector);
+	journal->End();
+	return success;
+}
+
+void FileSystem::freeSector(int sector) {
+	ASSERT(freeMap->Test(sector));
+	journal->Begin();
+	freeMap->Clear(sector);
+	freeMap->WriteBack(freeMapFile);
+	journal->End();
+}
+
+/*
+ 分割文件名称， 获得其所属文件夹
+ */
+
+int FileSystem::findFatherDirectory(char *name, int pwdSec) {
+	char *tmp = name;
+	if (*tmp == '/') {
+		tmp++;
+		name++;
+	}
+	int len = 0;
+	while (*tmp != '\0' && tmp != 0 && *tmp != '/') {
+		len++;
+		tmp++;
+	}
+	if (tmp == 0 || *tmp == '\0') { // 文件
+		return pwdSec;
+	} else { // 文件夹
+		char *fileName = new char[len + 1];
+		memcpy(fileName, name, len);
+		fileName[len] = '\0';
+		int childSec = lookup(pwdSec, fileName);
+		delete [] fileName;
+		if (childSec == -1)
+			return -1;
+		return findFatherDirectory(tmp, childSec);
+	}
+}
+
+//----------------------------------------------------------------------
+// FileSystem::lookup
+// 	Return the sector of the header of file "name" in the directory
+//	whose header is at "dirSec", or -1 if there is no such file.
+//	Answers, including "not found", are remembered in nameCache, so
+//	repeated lookups of the same path do not touch the directory.
+//----------------------------------------------------------------------
+
+int FileSystem::lookup(int dirSec, char *name) {
+	int sector;
+	if (nameCache->Lookup(dirSec, name, &sector))
+		return sector;
+	Directory *directory = new Directory(dirSec);
+	sector = directory->Find(name);
+	delete directory;
+	nameCache->Enter(dirSec, name, sector == -1 ? NameNotFound : sector);
+	return sector;
+}
+
+char *FileSystem::getFileName(char *abName) {
+	int lastSep = -1;
+	int i = 0;
+	char *tmp = abName;
+	for (int j = strlen(abName) - 1; j >= 0; j--) {
+		if (abName[j] == '/') {
+			lastSep = j;
+			break;
+		}
+	}
+	if (lastSep == -1)
+		return abName;
+	return abName + lastSep + 1;
+}
+
+/*
+ 在系统打开文件表中查找文件头在sec的文件，返回下标，没有打开返回-1
+ */
+int FileSystem::openFileIndex(int sec) {
+	for (int i = fileBuckets[sec % FILE_TABLE_BUCKETS]; i != -1; i = fileTable[i].next) {
+		if (fileTable[i].headSec == sec)
+			return i;
+	}
+	return -1;
+}
+OpenFileTable *FileSystem::addFile2OpenTable(int sec, Directory* father, char *name) {
+	int index = freeEntry;
+	if (index == -1)
+		return 0;
+	freeEntry = fileTable[index].next;
+	fileTable[index].next = fileBuckets[sec % FILE_TABLE_BUCKETS];
+	fileBuckets[sec % FILE_TABLE_BUCKETS] = index;
+	fileTable[index].fileHdr = headerCache->Get(sec);
+	fileTable[index].headSec = sec;
+	fileTable[index].openCount = 1;
+	fileTable[index].father = father;
+	strncpy(fileTable[index].name, name, FileNameMaxLen);
+	fileTable[index].name[FileNameMaxLen] = '\0';
+	return &fileTable[index];
+}
+
+int FileSystem::fread(OpenFile *file, char *into, int numBytes) {
+	OpenFileTable *entry = file->entry;
+	if (entry == 0)
+		return -1;
+	entry->lock->prepareRead();
+	int count = file->Read(into, numBytes);
+	entry->lock->doneRead();
+	return count;
+}
+int FileSystem::fwrite(OpenFile *file, char *into, int numBytes) {
+	OpenFileTable *entry = file->entry;
+	if (entry == 0)
+		return -1;
+	entry->lock->prepareWrite();
+	int count = file->Write(into, numBytes);
+	entry->lock->doneWrite();
+	return count;
+}
+int FileSystem::fpread(OpenFile *file, char *into, int numBytes, int position) {
+	OpenFileTable *entry = file->entry;
+	if (entry == 0 || position < 0)
+		return -1;
+	entry->lock->prepareRead();
+	int count = file->ReadAt(into, numBytes, position);
+	entry->lock->doneRead();
+	return count;
+}
+int FileSystem::fpwrite(OpenFile *file, char *from, int numBytes, int position) {
+	OpenFileTable *entry = file->entry;
+	if (entry == 0 || position < 0)
+		return -1;
+	entry->lock->prepareWrite();
+	int count = file->WriteAt(from, numBytes, position);
+	entry->lock->doneWrite();
+	return count;
+}
+
+//----------------------------------------------------------------------
+// FileSystem::fsync
+// 	Make one file durable: write its data sectors home first, then log
+//	its header (length and extents) and commit the journal, so after a
+//	crash the header never points at data that was not written.  Other
+//	files' dirty blocks stay in the cache.
+//----------------------------------------------------------------------
+
+int FileSystem::fsync(OpenFile *file) {
+	OpenFileTable *entry = file->entry;
+	if (entry == 0)
+		return -1;
+	entry->lock->prepareWrite();		// 期间文件的extent不会变
+	FileHeader *hdr = entry->fileHdr;
+	int numSectors = divRoundUp(hdr->FileLength(), SectorSize);
+	int *sectors = new int[numSectors];
+	int count = 0;
+	if (!hdr->IsInline()) {			// 内联文件的内容在文件头里
+		for (int i = 0; i < numSectors; i++) {
+			int sector = hdr->Lookup(i * SectorSize);
+			if (sector != -1)	// 空洞没有扇区
+				sectors[count++] = sector;
+		}
+	}
+	bufferCache->FlushSectors(sectors, count);
+	delete [] sectors;
+
+	journal->Begin();
+	hdr->WriteBack(entry->headSec);
+	journal->End();
+	journal->Commit();
+	entry->lock->doneWrite();
+	return 0;
+}
+
+//----------------------------------------------------------------------
+// FileSystem::BeginBulk/BulkCreate/BulkAdd/EndBulk
+// 	Bulk loading, for Import at boot when nothing else is using the
+//	file system.  BeginBulk checkpoints and suspends the journal.
+//	BulkCreate takes a header sector and the file's data sectors from
+//	the in-memory bitmap -- as few contiguous runs as FindRun can give
+//	-- without writing the bitmap; the caller writes the data straight
+//	to disk.  BulkAdd puts all the new names of one directory in with
+//	a single rebuild of its table.  EndBulk writes the headers and the
+//	bitmap once and resumes the journal.
+//
+//	Nothing in between is atomic: a crash during an import can leave
+//	directory entries on disk whose sectors the bitmap does not know
+//	about, so the disk has to be formatted and loaded again.
+//----------------------------------------------------------------------
+
+void FileSystem::BeginBulk() {
+	headerCache->Flush();
+	journal->Suspend();
+}
+
+FileHeader *FileSystem::BulkCreate(int length, bool isFile, int *sector) {
+	*sector = freeMap->Find();
+	if (*sector == -1)
+		return NULL;
+	FileHeader *hdr = headerCache->Get(*sector, FALSE);
+	if (!isFile || length <= InlineSize) {	// 目录和小文件：内容放在文件头里
+		hdr->init(this);
+		if (isFile)
+			hdr->setFileLength(0);
+	} else if (!hdr->Allocate(freeMap, length)) {
+		hdr->Deallocate(freeMap);	// 磁盘满了
+		freeMap->Clear(*sector);
+		headerCache->Discard(hdr);
+		return NULL;
+	}
+	return hdr;
+}
+
+bool FileSystem::BulkAdd(int dirSec, DirectoryEntry *entries, int count) {
+	OpenFile *dirFile = new OpenFile(dirSec);
+	dirFile->filesys = this;
+	Directory *dir = new Directory();
+	dir->FetchFrom(dirFile);
+	bool success = dir->AddAll(entries, count, freeMap);
+	if (success)
+		for (int i = 0; i < count; i++)
+			nameCache->Enter(dirSec, entries[i].name, entries[i].sector);
+	delete dir;
+	delete dirFile;		// 目录的文件头在EndBulk时写回
+	return success;
+}
+
+void FileSystem::EndBulk() {
+	headerCache->Flush();
+	freeMap->WriteBack(freeMapFile);	// 位图只写这一次
+	bufferCache->Flush();
+	journal->Resume();
+}
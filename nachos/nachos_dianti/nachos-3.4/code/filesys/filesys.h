@@ -1,143 +1,182 @@
-// filesys.h
-//	Data structures to represent the Nachos file system.
-//
-//	A file system is a set of files stored on disk, organized
-//	into directories.  Operations on the file system have to
-//	do with "naming" -- creating, opening, and deleting files,
-//	given a textual file name.  Operations on an individual
-//	"open" file (read, write, close) are to be found in the OpenFile
-//	class (openfile.h).
-//
-//	We define two separate implementations of the file system.
-//	The "STUB" version just re-defines the Nachos file system
-//	operations as operations on the native UNIX file system on the machine
-//	running the Nachos simulation.  This is provided in case the
-//	multiprogramming and virtual memory assignments (which make use
-//	of the file system) are done before the file system assignment.
-//
-//	The other version is a "real" file system, built on top of
-//	a disk simulator.  The disk is simulated using the native UNIX
-//	file system (in a file named "DISK").
-//
-//	In the "real" implementation, there are two key data structures used
-//	in the file system.  There is a single "root" directory, listing
-//	all of the files in the file system; unlike UNIX, the baseline
-//	system does not provide a hierarchical directory structure.
-//	In addition, there is a bitmap for allocating
-//	disk sectors.  Both the root directory and the bitmap are themselves
-//	stored as files in the Nachos file system -- this causes an interesting
-//	bootstrap problem when the simulated disk is initialized.
-//
-// Copyright (c) 1992-1993 The Regents of the University of California.
-// All rights reserved.  See copyright.h for copyright notice and limitation
-// of liability and disclaimer of warranty provisions.
-
-#ifndef FS_H
-#define FS_H
-
-#include "copyright.h"
-#include "openfile.h"
-#include "synch.h"
-
-#define ALL_FILE_TABLE_SIZE 1024
-
-#ifdef FILESYS_STUB // Temporarily implement file system calls as
-// calls to UNIX, until the real file system
-// implementation is available
-class FileSystem
-{
-public:
-	FileSystem(bool format) {}
-
-	bool Create(char *name, int initialSize)
-	{
-		int fileDescriptor = OpenForWrite(name);
-
-		if (fileDescriptor == -1)
-			return FALSE;
-		Close(fileDescriptor);
-		return TRUE;
-	}
-
-	OpenFile *Open(char *name)
-	{
-		int fileDescriptor = OpenForReadWrite(name, FALSE);
-
-		if (fileDescriptor == -1)
-			return NULL;
-		return new OpenFile(fileDescriptor);
-	}
-
-	bool Remove(char *name) { return Unlink(name) == 0; }
-};
-
-#else // FILESYS
-class Directory;
-class OpenFileTable
-{ // 用于管理所有的打开文件
-public:
-	int headSec;
-	FileHeader *fileHdr;
-	int openCount;
-	bool toRemove;
-	Directory* father;
-	ReadWriteLock *lock;
-	OpenFileTable()
-	{
-		headSec = -1;
-		fileHdr = 0;
-		openCount = 0;
-		toRemove = FALSE;
-		father = 0;
-		lock = new ReadWriteLock();
-	}
-};
-class FileSystem
-{
-public:
-	FileSystem(bool format); // Initialize the file system.
-							 // Must be called *after* "synchDisk"
-							 // has been initialized.
-							 // If "format", there is nothing on
-							 // the disk, so initialize the directory
-							 // and the bitmap of free blocks.
-
-	bool Create(char *name, int initialSize, bool isFile);
-	// Create a file (UNIX creat)
-
-	OpenFile *Open(char *name); // Open a file (UNIX open)
-
-	void Close(OpenFile *openFile); // 关闭一个打开文件
-
-	bool Remove(char *name); // Delete a file (UNIX unlink)
-
-	void List(); // List all the files in the file system
-
-	void Print(); // List all the files and their contents
-
-	int findEmptySector(); // 返回一个可用的磁盘块号
-
-	int findFatherDirectory(char *name, int pwdSec); // 分割字符串，依次遍历目录结构找到该文件所属的文件夹
-
-	char *getFileName(char *abName);
-
-	int openFileIndex(int sec);
-	int openFileIndex(OpenFile *file);
-
-	FileHeader *addFile2OpenTable(int sec, Directory* father);
-
-	int fread(OpenFile *file, char *into, int numBytes);
-	int fwrite(OpenFile *file, char *into, int numBytes);
-
-private:
-	bool deleteFile(int sec, Directory* directory);
-	OpenFile *freeMapFile;		 // Bit map of free disk blocks,
-								 // represented as a file
-	OpenFile *rootDirectoryFile; // "Root" directory -- list of
-								 // file names, represented as a file
-	OpenFileTable *fileTable;
-};
-
-#endif // FILESYS
-
-#endif // FS_H
+// filesys.h
+//	Data structures to represent the Nachos file system.
+//
+//	A file system is a set of files stored on disk, organized
+//	into directories.  Operations on the file system have to
+//	do with "naming" -- creating, opening, and deleting files,
+//	given a textual file name.  Operations on an individual
+//	"open" file (read, write, close) are to be found in the OpenFile
+//	class (openfile.h).
+//
+//	We define two separate implementations of the file system.
+//	The "STUB" version just re-defines the Nachos file system
+//	operations as operations on the native UNIX file system on the machine
+//	running the Nachos simulation.  This is provided in case the
+//	multiprogramming and virtual memory assignments (which make use
+//	of the file system) are done before the file system assignment.
+//
+//	The other version is a "real" file system, built on top of
+//	a disk simulator.  The disk is simulated using the native UNIX
+//	file system (in a file named "DISK").
+//
+//	In the "real" implementation, there are two key data structures used
+//	in the file system.  There is a single "root" directory, listing
+//	all of the files in the file system; unlike UNIX, the baseline
+//	system does not provide a hierarchical directory structure.
+//	In addition, there is a bitmap for allocating
+//	disk sectors.  Both the root directory and the bitmap are themselves
+//	stored as files in the Nachos file system -- this causes an interesting
+//	bootstrap problem when the simulated disk is initialized.
+//
+// Copyright (c) 1992-1993 The Regents of the University of California.
+// All rights reserved.  See copyright.h for copyright notice and limitation
+// of liability and disclaimer of warranty provisions.
+
+#ifndef FS_H
+#define FS_H
+
+#include "copyright.h"
+#include "openfile.h"
+#include "bitmap.h"
+#include "namecache.h"
+#include "synch.h"
+
+#define ALL_FILE_TABLE_SIZE 1024
+#define FILE_TABLE_BUCKETS 256 // 系统打开文件表按文件头扇区散列的桶数
+
+// Sectors containing the file headers for the bitmap of free sectors,
+// and the directory of files.  These file headers are placed in well-known
+// sectors, so that they can be located on boot-up.
+#define FreeMapSector 0
+#define RootDirectorySector 1
+#define FreeMapDataSector 2
+
+#ifdef FILESYS_STUB // Temporarily implement file system calls as
+// calls to UNIX, until the real file system
+// implementation is available
+class FileSystem
+{
+public:
+	FileSystem(bool format) {}
+
+	bool Create(char *name, int initialSize)
+	{
+		int fileDescriptor = OpenForWrite(name);
+
+		if (fileDescriptor == -1)
+			return FALSE;
+		Close(fileDescriptor);
+		return TRUE;
+	}
+
+	OpenFile *Open(char *name)
+	{
+		int fileDescriptor = OpenForReadWrite(name, FALSE);
+
+		if (fileDescriptor == -1)
+			return NULL;
+		return new OpenFile(fileDescriptor);
+	}
+
+	bool Remove(char *name) { return Unlink(name) == 0; }
+};
+
+#else // FILESYS
+class Directory;
+class DirectoryEntry;
+class OpenFileTable
+{ // 用于管理所有的打开文件
+public:
+	int headSec;
+	char name[FileNameMaxLen + 1]; // 在father中的名字，最后一次关闭时删除文件要用
+	FileHeader *fileHdr;
+	int openCount;
+	bool toRemove;
+	bool hdrDirty;	// 有OpenFile写过文件，最后一次关闭时要写回文件头
+	Directory* father;
+	ReadWriteLock *lock;
+	int next;	// 使用中：同一个散列桶中的下一项；空闲：下一个空闲项；-1表示结束
+	OpenFileTable()
+	{
+		headSec = -1;
+		name[0] = '\0';
+		fileHdr = 0;
+		openCount = 0;
+		toRemove = FALSE;
+		hdrDirty = FALSE;
+		father = 0;
+		lock = new ReadWriteLock();
+		next = -1;
+	}
+};
+class FileSystem
+{
+public:
+	FileSystem(bool format); // Initialize the file system.
+							 // Must be called *after* "synchDisk"
+							 // has been initialized.
+							 // If "format", there is nothing on
+							 // the disk, so initialize the directory
+							 // and the bitmap of free blocks.
+
+	bool Create(char *name, int initialSize, bool isFile);
+	// Create a file (UNIX creat)
+
+	OpenFile *Open(char *name); // Open a file (UNIX open)
+
+	void Close(OpenFile *openFile); // 关闭一个打开文件
+
+	OpenFile *Dup(OpenFile *file); // 复制打开文件，共享系统打开文件表中的表项
+
+	bool Remove(char *name); // Delete a file (UNIX unlink)
+
+	void List(); // List all the files in the file system
+
+	void Print(); // List all the files and their contents
+
+	int findEmptySector(); // 返回一个可用的磁盘块号
+	// 为文件分配扇区，直到有numSectors个；hdrSector不是-1时文件头和位图记入同一个事务
+	bool extendFile(FileHeader *hdr, int numSectors, bool prealloc, int hdrSector = -1);
+	bool fillHole(FileHeader *hdr, int logical, bool prealloc, int hdrSector = -1); // 给文件的第logical个扇区分配磁盘块（见FileHeader::Fill）
+	void freeSector(int sector); // 释放一个磁盘块
+
+	int findFatherDirectory(char *name, int pwdSec); // 分割字符串，依次遍历目录结构找到该文件所属的文件夹
+
+	char *getFileName(char *abName);
+
+	int openFileIndex(int sec);
+
+	OpenFileTable *addFile2OpenTable(int sec, Directory* father, char *name);
+	void releaseEntry(OpenFileTable *entry); // 打开计数减一，为0时释放表项
+
+	int fread(OpenFile *file, char *into, int numBytes);
+	int fwrite(OpenFile *file, char *into, int numBytes);
+	int fpread(OpenFile *file, char *into, int numBytes, int position);  // 指定位置读写，
+	int fpwrite(OpenFile *file, char *from, int numBytes, int position); // 不改变文件的读写位置
+	int fsync(OpenFile *file); // 只把这个文件的数据和文件头写到磁盘
+
+	// 批量装载（Import）：BeginBulk和EndBulk之间不记日志，扇区直接从freeMap
+	// 分配，位图和文件头在EndBulk时一次写回；期间不能有别的文件系统操作
+	void BeginBulk();
+	FileHeader *BulkCreate(int length, bool isFile, int *sector); // 新文件头，调用者Release；磁盘满返回NULL
+	bool BulkAdd(int dirSec, DirectoryEntry *entries, int count); // 一次加入目录的所有新表项
+	void EndBulk();
+
+private:
+	bool deleteFile(int sec, Directory* directory, char *name);
+	void createJournal();	// 分配日志区，建立空的日志
+	int lookup(int dirSec, char *name); // 在目录中查找文件头扇区，先查nameCache
+	OpenFile *freeMapFile;		 // Bit map of free disk blocks,
+								 // represented as a file
+	BitMap *freeMap;			 // 空闲位图常驻内存，修改后只写回改动的扇区
+	OpenFile *rootDirectoryFile; // "Root" directory -- list of
+								 // file names, represented as a file
+	OpenFileTable *fileTable;
+	int *fileBuckets;			 // 按headSec散列，值为fileTable的下标
+	int freeEntry;				 // 空闲表项链表的头
+	NameCache *nameCache;		 // 路径名查找缓存
+};
+
+#endif // FILESYS
+
+#endif // FS_H
@@ -1,240 +1,770 @@
-// fstest.cc
-//	Simple test routines for the file system.
-//
-//	We implement:
-//	   Copy -- copy a file from UNIX to Nachos
-//	   Print -- cat the contents of a Nachos file
-//	   Perftest -- a stress test for the Nachos file system
-//		read and write a really large file in tiny chunks
-//		(won't work on baseline system!)
-//
-// Copyright (c) 1992-1993 The Regents of the University of California.
-// All rights reserved.  See copyright.h for copyright notice and limitation
-// of liability and disclaimer of warranty provisions.
-
-#include "copyright.h"
-
-#include "utility.h"
-#include "filesys.h"
-#include "system.h"
-#include "thread.h"
-#include "disk.h"
-#include "stats.h"
-#include "directory.h"
-#define TransferSize 64 // make it small, just to be difficult
-
-//----------------------------------------------------------------------
-// Copy
-// 	Copy the contents of the UNIX file "from" to the Nachos file "to"
-//----------------------------------------------------------------------
-
-void Copy(char *from, char *to) {
-	FILE *fp;
-	OpenFile *openFile;
-	int amountRead, fileLength;
-	char *buffer;
-
-	// Open UNIX file
-	if ((fp = fopen(from, "r")) == NULL) {
-		printf("Copy: couldn't open input file %s\n", from);
-		return;
-	}
-
-	// Figure out length of UNIX file
-	fseek(fp, 0, 2);
-	fileLength = ftell(fp);
-	fseek(fp, 0, 0);
-
-	// Create a Nachos file of the same length
-	DEBUG('f', "Copying file %s, size %d, to file %s\n", from, fileLength, to);
-	if (!fileSystem->Create(to, fileLength, TRUE)) { // Create Nachos file
-		printf("Copy: couldn't create output file %s\n", to);
-		fclose(fp);
-		return;
-	}
-
-	openFile = fileSystem->Open(to);
-	ASSERT(openFile != NULL);
-
-	// Copy the data in TransferSize chunks
-	buffer = new char[TransferSize];
-	while ((amountRead = fread(buffer, sizeof(char), TransferSize, fp)) > 0)
-		openFile->Write(buffer, amountRead);
-	delete[] buffer;
-
-	// Close the UNIX and the Nachos files
-
-	fclose(fp);
-}
-
-//----------------------------------------------------------------------
-// Print
-// 	Print the contents of the Nachos file "name".
-//----------------------------------------------------------------------
-
-void Print(char *name) {
-	OpenFile *openFile;
-	int i, amountRead;
-	char *buffer;
-
-	if ((openFile = fileSystem->Open(name)) == NULL) {
-		printf("Print: unable to open file %s\n", name);
-		return;
-	}
-
-	buffer = new char[TransferSize];
-	while ((amountRead = openFile->Read(buffer, TransferSize)) > 0)
-		for (i = 0; i < amountRead; i++)
-			printf("%c", buffer[i]);
-	delete[] buffer;
-
-	delete openFile; // close the Nachos file
-	return;
-}
-
-//----------------------------------------------------------------------
-// PerformanceTest
-// 	Stress the Nachos file system by creating a large file, writing
-//	it out a bit at a time, reading it back a bit at a time, and then
-//	deleting the file.
-//
-//	Implemented as three separate routines:
-//	  FileWrite -- write the file
-//	  FileRead -- read the file
-//	  PerformanceTest -- overall control, and print out performance #'s
-//----------------------------------------------------------------------
-
-#define FileName "/home/li/test"
-#define Contents "1234567890"
-#define ContentSize strlen(Contents)
-#define FileSize ((int)(ContentSize * 5000))
-
-static void FileWrite() {
-	OpenFile *openFile;
-	int i, numBytes;
-
-	printf("Sequential write of %d byte file, in %d byte chunks\n",
-	FileSize, ContentSize);
-	if (!fileSystem->Create(FileName, 0, TRUE)) {
-		printf("Perf test: can't create %s\n", FileName);
-		return;
-	}
-	openFile = fileSystem->Open(FileName);
-	if (openFile == NULL) {
-		printf("Perf test: unable to open %s\n", FileName);
-		return;
-	}
-	for (i = 0; i < FileSize; i += ContentSize)
-	{
-		numBytes = openFile->Write(Contents, ContentSize);
-		if (numBytes < 10) {
-			printf("Perf test: unable to write %s\n", FileName);
-			delete openFile;
-			return;
-		}
-	}
-	delete openFile; // close file
-}
-
-static void FileRead() {
-	OpenFile *openFile;
-	char *buffer = new char[ContentSize];
-	int i, numBytes;
-
-	printf("Sequential read of %d byte file, in %d byte chunks\n",
-	FileSize, ContentSize);
-
-	if ((openFile = fileSystem->Open(FileName)) == NULL) {
-		printf("Perf test: unable to open file %s\n", FileName);
-		delete[] buffer;
-		return;
-	}
-	for (i = 0; i < FileSize; i += ContentSize)
-	{
-		numBytes = openFile->Read(buffer, ContentSize);
-		if ((numBytes < 10) || strncmp(buffer, Contents, ContentSize)) {
-			printf("Perf test: unable to read %s\n", FileName);
-			delete openFile;
-			delete[] buffer;
-			return;
-		}
-	}
-	delete[] buffer;
-	delete openFile; // close file
-}
-
-void PerformanceTest() {
-	printf("Starting file system performance test:\n");
-	stats->Print();
-	FileWrite();
-	FileRead();
-	if (!fileSystem->Remove(FileName)) {
-		printf("Perf test: unable to remove %s\n", FileName);
-		return;
-	}
-	stats->Print();
-}
-void testSynchRead() {
-	OpenFile* file = fileSystem->Open("/home/li/test");
-	for (int i = 0; i < 5; i++) {
-		char buf[10] = { };
-		fileSystem->fread(file, buf, 1);
-		printf("thread %s read 1 char from file , get char : %s\n",
-				currentThread->getName(), buf);
-		currentThread->Yield();
-	}
-}
-void testSynchWrite() {
-	OpenFile* file = fileSystem->Open("/home/li/test");
-	for (int i = 0; i < 5; i++) {
-		char* buf = "abcdefghijklmn";
-		fileSystem->fwrite(file, buf, 1);
-		printf("thread %s write 1 char from file , get char : %c\n",
-				currentThread->getName(), buf[i]);
-		currentThread->Yield();
-	}
-}
-
-void pipeRead(int arg) {
-	PipeFile* pipe = (PipeFile*) arg;
-	char buf[10] = { };
-
-	pipe->read(buf, 1);
-	printf("i an thread %s, you input %c in last thread\n",
-			currentThread->getName(), buf[0]);
-
-}
-void pipeWrite(int arg) {
-	PipeFile* pipe = (PipeFile*) arg;
-	printf(" i am thread %s , please input 1, 2, or 3\n",
-			currentThread->getName());
-	char c[10];
-	scanf("%s", &c);
-	pipe->write(c, 1);
-}
-void testFileSystem() {
-   fileSystem->Create("/home", 0, FALSE);
-   fileSystem->Create("/tmp", 0, FALSE);
-   fileSystem->Create("/home/li", 0, FALSE);
-   char* name1 = "/home/lihaiyang/NachosLab/nachos/nachos_dianti/nachos-3.4/code/test/thread1";
-   char* name2 = "/home/lihaiyang/NachosLab/nachos/nachos_dianti/nachos-3.4/code/test/thread2";
-   char* name3 = "/home/lihaiyang/NachosLab/nachos/nachos_dianti/nachos-3.4/code/test/sort";
-   Copy(name1, "/home/li/thread1");
-   Copy(name2, "/home/li/thread2");
-   Copy(name3, "/home/li/sort");
-//   Thread* t1 = new Thread("thread1");
-//   t1->Fork(testSynchRead, 0);
-////   Thread* t2 = new Thread("thread2");
-////   t2->Fork(testSynchRead, 0);
-//   Thread* t3 = new Thread("thrad3");
-//   t3->Fork(testSynchWrite, 0);
-
-	/*
-//	 * pipe test
-//	 * */
-//	PipeFile* pipe = new PipeFile();
-//	Thread* write = new Thread("write");
-//	write->Fork(pipeWrite, (void*) pipe);
-//	Thread* read = new Thread("read");
-//	read->Fork(pipeRead, (void*) pipe);
-}
+// fstest.cc
+//	Simple test routines for the file system.
+//
+//	We implement:
+//	   Copy -- copy a file from UNIX to Nachos
+//	   Import/Export -- bulk load a whole directory tree from UNIX
+//		into Nachos, and copy one back
+//	   Print -- cat the contents of a Nachos file
+//	   Perftest -- a stress test for the Nachos file system
+//		read and write a really large file in tiny chunks
+//		(won't work on baseline system!)
+//
+// Copyright (c) 1992-1993 The Regents of the University of California.
+// All rights reserved.  See copyright.h for copyright notice and limitation
+// of liability and disclaimer of warranty provisions.
+
+#include "copyright.h"
+
+#include "utility.h"
+#include "filesys.h"
+#include "system.h"
+#include "thread.h"
+#include "disk.h"
+#include "stats.h"
+#include "directory.h"
+#include "filehdr.h"
+
+#include <dirent.h>
+#include <sys/stat.h>
+#include <time.h>
+
+#define TransferSize 64 // make it small, just to be difficult
+#define BulkTransferSize (SectorsPerTrack * SectorSize) // 一次传一个磁道
+
+//----------------------------------------------------------------------
+// Copy
+// 	Copy the contents of the UNIX file "from" to the Nachos file "to"
+//	The file's sectors are reserved in one contiguous run when it is
+//	created, and the data goes in a track at a time, so every sector
+//	is written whole and none has to be read first.
+//----------------------------------------------------------------------
+
+void Copy(char *from, char *to) {
+	FILE *fp;
+	OpenFile *openFile;
+	int amountRead, fileLength;
+	char *buffer;
+
+	// Open UNIX file
+	if ((fp = fopen(from, "r")) == NULL) {
+		printf("Copy: couldn't open input file %s\n", from);
+		return;
+	}
+
+	// Figure out length of UNIX file
+	fseek(fp, 0, 2);
+	fileLength = ftell(fp);
+	fseek(fp, 0, 0);
+
+	// Create a Nachos file of the same length
+	DEBUG('f', "Copying file %s, size %d, to file %s\n", from, fileLength, to);
+	if (!fileSystem->Create(to, fileLength, TRUE)) { // Create Nachos file
+		printf("Copy: couldn't create output file %s\n", to);
+		fclose(fp);
+		return;
+	}
+
+	openFile = fileSystem->Open(to);
+	ASSERT(openFile != NULL);
+
+	// Copy the data in BulkTransferSize chunks
+	buffer = new char[BulkTransferSize];
+	while ((amountRead = fread(buffer, sizeof(char), BulkTransferSize, fp)) > 0)
+		openFile->Write(buffer, amountRead);
+	delete[] buffer;
+
+	// Close the UNIX and the Nachos files
+	delete openFile;
+	fclose(fp);
+}
+
+//----------------------------------------------------------------------
+// CopyOut
+// 	Copy the contents of the Nachos file "from" to the UNIX file "to"
+//----------------------------------------------------------------------
+
+static void CopyOut(char *from, char *to) {
+	FILE *fp;
+	OpenFile *openFile;
+	int amountRead;
+	char *buffer;
+
+	if ((openFile = fileSystem->Open(from)) == NULL) {
+		printf("Export: unable to open file %s\n", from);
+		return;
+	}
+	if ((fp = fopen(to, "w")) == NULL) {
+		printf("Export: couldn't create output file %s\n", to);
+		delete openFile;
+		return;
+	}
+	buffer = new char[BulkTransferSize];
+	while ((amountRead = openFile->Read(buffer, BulkTransferSize)) > 0)
+		fwrite(buffer, sizeof(char), amountRead, fp);
+	delete[] buffer;
+	delete openFile;
+	fclose(fp);
+}
+
+// "dir"/"name"，dir为"/"时不重复斜杠
+static char *JoinPath(char *dir, char *name) {
+	int len = strlen(dir);
+	char *path = new char[len + strlen(name) + 2];
+
+	if (len > 0 && dir[len - 1] == '/')
+		sprintf(path, "%s%s", dir, name);
+	else
+		sprintf(path, "%s/%s", dir, name);
+	return path;
+}
+
+// Import中的一个目录：新加入的表项先记在这里，全部文件写完之后一次加入
+class ImportDir {
+  public:
+	int sector;			// 目录的文件头扇区
+	bool existing;			// Import之前就有的目录，要检查重名
+	DirectoryEntry *entries;
+	int count, max;
+};
+
+static List *importDirs;
+
+static ImportDir *NewImportDir(int sector, bool existing) {
+	ImportDir *dir = new ImportDir;
+
+	dir->sector = sector;
+	dir->existing = existing;
+	dir->max = DirInitialSlots;
+	dir->entries = new DirectoryEntry[dir->max];
+	dir->count = 0;
+	importDirs->Append((void *) dir);
+	return dir;
+}
+
+static void AddImportEntry(ImportDir *dir, char *name, int sector, bool isFile) {
+	if (dir->count == dir->max) {
+		DirectoryEntry *entries = new DirectoryEntry[dir->max * 2];
+		for (int i = 0; i < dir->count; i++)
+			entries[i] = dir->entries[i];
+		delete[] dir->entries;
+		dir->entries = entries;
+		dir->max *= 2;
+	}
+	DirectoryEntry *e = &dir->entries[dir->count++];
+	strncpy(e->name, name, FileNameMaxLen);
+	e->sector = sector;
+	e->isDirectory = !isFile;
+	e->createDate = time(NULL);
+}
+
+// 名字已经在Import之前就有的目录里
+static bool ImportExists(ImportDir *dir, char *name) {
+	if (!dir->existing)
+		return FALSE;
+	Directory *directory = new Directory(dir->sector);
+	bool found = directory->Find(name) != -1;
+	delete directory;
+	return found;
+}
+
+// 把UNIX文件from作为dir中的name写进来：扇区已经由BulkCreate连续地
+// 分好，数据按extent直接写盘，一次最多MaxDiskTransfer个扇区
+static void ImportFile(char *from, ImportDir *dir, char *name) {
+	FILE *fp = fopen(from, "r");
+	if (fp == NULL) {
+		printf("Import: couldn't open %s\n", from);
+		return;
+	}
+	fseek(fp, 0, 2);
+	int length = ftell(fp);
+	fseek(fp, 0, 0);
+
+	int sector;
+	FileHeader *hdr = fileSystem->BulkCreate(length, TRUE, &sector);
+	if (hdr == NULL) {
+		printf("Import: disk full, skipping %s\n", from);
+		fclose(fp);
+		return;
+	}
+	char *buffer = new char[MaxDiskTransfer * SectorSize];
+	if (hdr->IsInline()) {
+		int amountRead = fread(buffer, sizeof(char), length, fp);
+		hdr->WriteInline(buffer, amountRead, 0);
+	} else {
+		int numSectors = divRoundUp(length, SectorSize);
+		for (int i = 0; i < numSectors; ) {
+			int start = hdr->Lookup(i * SectorSize);
+			int n = 1;
+			while (n < MaxDiskTransfer && i + n < numSectors
+					&& hdr->Lookup((i + n) * SectorSize) == start + n)
+				n++;
+			bzero(buffer, n * SectorSize);
+			fread(buffer, sizeof(char), n * SectorSize, fp);
+			bufferCache->Invalidate(start, n);	// 缓存里可能还有这些扇区以前的内容
+			synchDisk->WriteSectors(start, n, buffer);
+			i += n;
+		}
+	}
+	delete[] buffer;
+	fclose(fp);
+	headerCache->Release(hdr, TRUE);
+	AddImportEntry(dir, name, sector, TRUE);
+}
+
+static void ImportTree(char *from, ImportDir *parent) {
+	DIR *dir = opendir(from);
+	if (dir == NULL) {
+		printf("Import: couldn't read directory %s\n", from);
+		return;
+	}
+	struct dirent *d;
+	while ((d = readdir(dir)) != NULL) {
+		if (!strcmp(d->d_name, ".") || !strcmp(d->d_name, ".."))
+			continue;
+		if (strlen(d->d_name) > FileNameMaxLen) {
+			printf("Import: skipping %s/%s, name too long\n", from, d->d_name);
+			continue;
+		}
+		if (ImportExists(parent, d->d_name)) {
+			printf("Import: skipping %s/%s, already exists\n", from, d->d_name);
+			continue;
+		}
+		char *hostPath = JoinPath(from, d->d_name);
+		struct stat st;
+		if (stat(hostPath, &st) < 0) {
+			printf("Import: couldn't find %s\n", hostPath);
+		} else if (!S_ISDIR(st.st_mode)) {
+			ImportFile(hostPath, parent, d->d_name);
+		} else {
+			int sector;
+			FileHeader *hdr = fileSystem->BulkCreate(0, FALSE, &sector);
+			if (hdr == NULL) {
+				printf("Import: disk full, skipping %s\n", hostPath);
+			} else {
+				headerCache->Release(hdr, TRUE);
+				AddImportEntry(parent, d->d_name, sector, FALSE);
+				ImportTree(hostPath, NewImportDir(sector, FALSE));
+			}
+		}
+		delete[] hostPath;
+	}
+	closedir(dir);
+}
+
+// Nachos路径name的文件头扇区，不存在返回-1
+static int ImportLookup(char *name) {
+	if (!strcmp(name, "/"))
+		return RootDirectorySector;
+	int fatherSec = fileSystem->findFatherDirectory(name, RootDirectorySector);
+	if (fatherSec == -1)
+		return -1;
+	Directory *father = new Directory(fatherSec);
+	int sector = father->Find(fileSystem->getFileName(name));
+	delete father;
+	return sector;
+}
+
+//----------------------------------------------------------------------
+// Import
+// 	Bulk load the UNIX file or directory tree "from" to the Nachos
+//	path "to" (nachos -import, at boot, with nothing else running).
+//	A directory tree goes into the directory "to", which is created
+//	if it does not exist; names that are already there are skipped.
+//
+//	The journal is suspended for the duration (FileSystem::BeginBulk).
+//	Each file's sectors are reserved as contiguous runs straight from
+//	the bitmap and its data written to disk a transfer at a time; the
+//	new names of each directory are put in with one rebuild of its
+//	table after the last file, and the headers and the bitmap are
+//	written once at the end.
+//----------------------------------------------------------------------
+
+void Import(char *from, char *to) {
+	int ticks = stats->totalTicks;
+	struct stat st;
+
+	if (stat(from, &st) < 0) {
+		printf("Import: couldn't find %s\n", from);
+		return;
+	}
+	bool isDir = S_ISDIR(st.st_mode);
+	if (isDir && ImportLookup(to) == -1)
+		fileSystem->Create(to, 0, FALSE);
+	int dirSec = isDir ? ImportLookup(to)
+			: fileSystem->findFatherDirectory(to, RootDirectorySector);
+	if (dirSec == -1) {
+		printf("Import: couldn't find directory for %s\n", to);
+		return;
+	}
+
+	fileSystem->BeginBulk();
+	importDirs = new List();
+	ImportDir *top = NewImportDir(dirSec, TRUE);
+	if (isDir)
+		ImportTree(from, top);
+	else if (ImportExists(top, fileSystem->getFileName(to)))
+		printf("Import: %s already exists\n", to);
+	else
+		ImportFile(from, top, fileSystem->getFileName(to));
+
+	while (!importDirs->IsEmpty()) {
+		ImportDir *dir = (ImportDir *) importDirs->Remove();
+		if (dir->count > 0
+				&& !fileSystem->BulkAdd(dir->sector, dir->entries, dir->count))
+			printf("Import: disk full, directory %d left incomplete\n", dir->sector);
+		delete[] dir->entries;
+		delete dir;
+	}
+	delete importDirs;
+	fileSystem->EndBulk();
+	DEBUG('f', "Imported %s to %s in %d ticks\n", from, to,
+			stats->totalTicks - ticks);
+}
+
+//----------------------------------------------------------------------
+// Export
+// 	Copy the Nachos directory tree "from" ("/" for the whole disk) to
+//	the UNIX directory "to", which is created if it does not exist.
+//----------------------------------------------------------------------
+
+void Export(char *from, char *to) {
+	OpenFile *dirFile = NULL;
+	Directory *dir;
+	DirectoryEntry *entries;
+	int count;
+
+	if (!strcmp(from, "/")) {
+		dir = new Directory(RootDirectorySector);
+	} else {
+		if ((dirFile = fileSystem->Open(from)) == NULL) {
+			printf("Export: unable to open directory %s\n", from);
+			return;
+		}
+		dir = new Directory();
+		dir->FetchFrom(dirFile);
+	}
+	mkdir(to, 0777);
+	entries = dir->Entries(&count);
+	for (int i = 0; i < count; i++) {
+		char *nachosPath = JoinPath(from, entries[i].name);
+		char *hostPath = JoinPath(to, entries[i].name);
+		if (entries[i].isDirectory)
+			Export(nachosPath, hostPath);
+		else
+			CopyOut(nachosPath, hostPath);
+		delete[] nachosPath;
+		delete[] hostPath;
+	}
+	delete[] entries;
+	delete dir;
+	if (dirFile != NULL)
+		delete dirFile;
+}
+
+//----------------------------------------------------------------------
+// Print
+// 	Print the contents of the Nachos file "name".
+//----------------------------------------------------------------------
+
+void Print(char *name) {
+	OpenFile *openFile;
+	int i, amountRead;
+	char *buffer;
+
+	if ((openFile = fileSystem->Open(name)) == NULL) {
+		printf("Print: unable to open file %s\n", name);
+		return;
+	}
+
+	buffer = new char[TransferSize];
+	while ((amountRead = openFile->Read(buffer, TransferSize)) > 0)
+		for (i = 0; i < amountRead; i++)
+			printf("%c", buffer[i]);
+	delete[] buffer;
+
+	delete openFile; // close the Nachos file
+	return;
+}
+
+//----------------------------------------------------------------------
+// PerformanceTest
+// 	Stress the Nachos file system by creating a large file, writing
+//	it out a bit at a time, reading it back a bit at a time, and then
+//	deleting the file.
+//
+//	Implemented as three separate routines:
+//	  FileWrite -- write the file
+//	  FileRead -- read the file
+//	  PerformanceTest -- overall control, and print out performance #'s
+//----------------------------------------------------------------------
+
+#define FileName "/home/li/test"
+#define Contents "1234567890"
+#define ContentSize strlen(Contents)
+#define FileSize ((int)(ContentSize * 5000))
+
+static void FileWrite() {
+	OpenFile *openFile;
+	int i, numBytes;
+
+	printf("Sequential write of %d byte file, in %d byte chunks\n",
+	FileSize, ContentSize);
+	if (!fileSystem->Create(FileName, 0, TRUE)) {
+		printf("Perf test: can't create %s\n", FileName);
+		return;
+	}
+	openFile = fileSystem->Open(FileName);
+	if (openFile == NULL) {
+		printf("Perf test: unable to open %s\n", FileName);
+		return;
+	}
+	for (i = 0; i < FileSize; i += ContentSize)
+	{
+		numBytes = openFile->Write(Contents, ContentSize);
+		if (numBytes < 10) {
+			printf("Perf test: unable to write %s\n", FileName);
+			delete openFile;
+			return;
+		}
+	}
+	delete openFile; // close file
+}
+
+static void FileRead() {
+	OpenFile *openFile;
+	char *buffer = new char[ContentSize];
+	int i, numBytes;
+
+	printf("Sequential read of %d byte file, in %d byte chunks\n",
+	FileSize, ContentSize);
+
+	if ((openFile = fileSystem->Open(FileName)) == NULL) {
+		printf("Perf test: unable to open file %s\n", FileName);
+		delete[] buffer;
+		return;
+	}
+	for (i = 0; i < FileSize; i += ContentSize)
+	{
+		numBytes = openFile->Read(buffer, ContentSize);
+		if ((numBytes < 10) || strncmp(buffer, Contents, ContentSize)) {
+			printf("Perf test: unable to read %s\n", FileName);
+			delete openFile;
+			delete[] buffer;
+			return;
+		}
+	}
+	delete[] buffer;
+	delete openFile; // close file
+}
+
+void PerformanceTest() {
+	printf("Starting file system performance test:\n");
+	stats->Print();
+	FileWrite();
+	FileRead();
+	if (!fileSystem->Remove(FileName)) {
+		printf("Perf test: unable to remove %s\n", FileName);
+		return;
+	}
+	stats->Print();
+}
+void testSynchRead() {
+	OpenFile* file = fileSystem->Open("/home/li/test");
+	for (int i = 0; i < 5; i++) {
+		char buf[10] = { };
+		fileSystem->fread(file, buf, 1);
+		printf("thread %s read 1 char from file , get char : %s\n",
+				currentThread->getName(), buf);
+		currentThread->Yield();
+	}
+}
+void testSynchWrite() {
+	OpenFile* file = fileSystem->Open("/home/li/test");
+	for (int i = 0; i < 5; i++) {
+		char* buf = "abcdefghijklmn";
+		fileSystem->fwrite(file, buf, 1);
+		printf("thread %s write 1 char from file , get char : %c\n",
+				currentThread->getName(), buf[i]);
+		currentThread->Yield();
+	}
+}
+
+void pipeRead(int arg) {
+	PipeFile* pipe = (PipeFile*) arg;
+	char buf[10] = { };
+
+	pipe->read(buf, 1);
+	printf("i an thread %s, you input %c in last thread\n",
+			currentThread->getName(), buf[0]);
+
+}
+void pipeWrite(int arg) {
+	PipeFile* pipe = (PipeFile*) arg;
+	printf(" i am thread %s , please input 1, 2, or 3\n",
+			currentThread->getName());
+	char c[10];
+	scanf("%s", &c);
+	pipe->write(c, 1);
+}
+//----------------------------------------------------------------------
+// DiskSchedTest
+// 	Several threads read sectors scattered over the whole disk at the
+//	same time, bypassing the buffer cache, so that the disk request
+//	queue always holds requests from different threads.  Prints the
+//	average seek distance and request latency under the disk scheduling
+//	policy chosen with -ds; run "nachos -ds <policy> -dt" once per
+//	policy to compare.
+//----------------------------------------------------------------------
+
+#define SchedReaders 4
+#define SchedReads 16
+
+static Semaphore *schedDone;
+
+static void SchedReader(int which) {
+	char buf[SectorSize];
+	for (int i = 0; i < SchedReads; i++) {
+		int track = (which * 11 + i * 7) % NumTracks; // 各线程交错访问不同磁道
+		synchDisk->ReadSector(track * SectorsPerTrack + which, buf);
+	}
+	schedDone->V();
+}
+
+void DiskSchedTest() {
+	int requests = stats->numDiskReads + stats->numDiskWrites;
+	int seeks = stats->diskSeekTracks;
+	int waits = stats->diskWaitTicks;
+
+	schedDone = new Semaphore("disk sched test", 0);
+	for (int i = 0; i < SchedReaders; i++) {
+		Thread* t = new Thread("disk reader");
+		t->Fork(SchedReader, (void*) i);
+	}
+	for (int i = 0; i < SchedReaders; i++)
+		schedDone->P();
+	delete schedDone;
+
+	requests = stats->numDiskReads + stats->numDiskWrites - requests;
+	printf("Disk scheduling %s: %d requests, average seek %d tracks, "
+			"average latency %d ticks\n", synchDisk->PolicyName(), requests,
+			(stats->diskSeekTracks - seeks) / requests,
+			(stats->diskWaitTicks - waits) / requests);
+}
+
+//----------------------------------------------------------------------
+// LargeFileTest
+// 	Stress test for large files (nachos -lf).
+//
+//	First a sparse file is made of more extents than the direct, single
+//	and double indirect levels hold: one byte is written in every other
+//	sector, so each write gets an extent of its own (a hole in the
+//	middle of a file is filled with exactly one sector and never
+//	preallocated).  The last byte is written first, so that every later
+//	write fills a hole instead of growing the file.  The test checks
+//	that indirect[1] and indirect[2] were allocated and reads the whole
+//	file back, holes included.
+//
+//	Then the free space is cut into small holes (create a run of small
+//	files and remove every other one), and files of growing size, up to
+//	most of the free disk, are written in small chunks with a pattern
+//	that depends on the offset, read back and checked, and removed.
+//	The sizes follow the disk geometry, so on a multi-megabyte disk the
+//	files are multi-megabyte too.
+//----------------------------------------------------------------------
+
+#define FragFiles 64
+#define LargeChunk 100
+// 一、二级间接索引用完之后再多几个extent，需要三级间接块
+#define SparseExtents (NumDirectExtents + ExtentsPerSector * (1 + PointersPerSector) + 8)
+
+static char LargePattern(int offset) {
+	return (char) ((offset * 7 + offset / SectorSize) & 0xff);
+}
+
+static bool SparseFileRun(char *name) {
+	char *buf = new char[SectorSize];
+	OpenFile *openFile;
+	bool ok = TRUE;
+	int i, j, offset;
+
+	if (!fileSystem->Create(name, 0, TRUE)
+			|| (openFile = fileSystem->Open(name)) == NULL) {
+		printf("Large file test: can't create %s\n", name);
+		delete[] buf;
+		return FALSE;
+	}
+	offset = 2 * (SparseExtents - 1) * SectorSize;	// 先写最后一个字节
+	buf[0] = LargePattern(offset);
+	ok = (openFile->WriteAt(buf, 1, offset) == 1);
+	for (i = 0; i < SparseExtents - 1 && ok; i++) {
+		offset = 2 * i * SectorSize;
+		buf[0] = LargePattern(offset);
+		ok = (openFile->WriteAt(buf, 1, offset) == 1);
+	}
+
+	FileHeader *hdr = openFile->entry->fileHdr;
+	printf("Large file test: sparse file has %d extents, indirect %d %d %d\n",
+			hdr->NumExtents(), hdr->IndirectSector(0), hdr->IndirectSector(1),
+			hdr->IndirectSector(2));
+	ok = ok && hdr->NumExtents() >= SparseExtents
+			&& hdr->IndirectSector(1) != -1 && hdr->IndirectSector(2) != -1;
+
+	for (i = 0; i < 2 * SparseExtents - 1 && ok; i++) {
+		offset = i * SectorSize;
+		int n = openFile->ReadAt(buf, SectorSize, offset);
+		ok = (n == ((i == 2 * SparseExtents - 2) ? 1 : SectorSize));
+		for (j = 0; j < n && ok; j++)
+			ok = (buf[j] == ((i % 2 == 0 && j == 0) ? LargePattern(offset) : 0));
+	}
+	printf("Large file test: sparse file %s\n", ok ? "ok" : "FAILED");
+	delete openFile;
+	fileSystem->Remove(name);
+	delete[] buf;
+	return ok;
+}
+
+static bool LargeFileRun(char *name, int size) {
+	char *buf = new char[LargeChunk];
+	OpenFile *openFile;
+	bool ok = TRUE;
+	int i, j, n;
+
+	if (!fileSystem->Create(name, 0, TRUE)
+			|| (openFile = fileSystem->Open(name)) == NULL) {
+		printf("Large file test: can't create %s\n", name);
+		delete[] buf;
+		return FALSE;
+	}
+	for (i = 0; i < size && ok; i += n) {
+		n = (size - i < LargeChunk) ? size - i : LargeChunk;
+		for (j = 0; j < n; j++)
+			buf[j] = LargePattern(i + j);
+		ok = (openFile->Write(buf, n) == n);
+	}
+	openFile->Seek(0);
+	for (i = 0; i < size && ok; i += n) {
+		n = (size - i < LargeChunk) ? size - i : LargeChunk;
+		ok = (openFile->Read(buf, n) == n);
+		for (j = 0; j < n && ok; j++)
+			ok = (buf[j] == LargePattern(i + j));
+	}
+	printf("Large file test: %d bytes %s\n", size, ok ? "ok" : "FAILED");
+	delete openFile;
+	fileSystem->Remove(name);
+	delete[] buf;
+	return ok;
+}
+
+void LargeFileTest() {
+	char name[FileNameMaxLen + 2];
+	char *data = new char[2 * SectorSize];
+	int ticks = stats->totalTicks;
+	int i;
+
+	SparseFileRun("/sparse");
+
+	memset(data, 'x', 2 * SectorSize);
+	for (i = 0; i < FragFiles; i++) {	// 把空闲空间切成小块
+		sprintf(name, "/frag%d", i);
+		fileSystem->Create(name, 0, TRUE);
+		OpenFile *f = fileSystem->Open(name);
+		if (f == NULL)
+			break;
+		f->Write(data, 2 * SectorSize);
+		delete f;
+	}
+	for (i = 0; i < FragFiles; i += 2) {
+		sprintf(name, "/frag%d", i);
+		fileSystem->Remove(name);
+	}
+
+	for (int size = 4 * SectorSize; size <= NumSectors * SectorSize / 2;
+			size *= 2)
+		if (!LargeFileRun("/large", size))
+			break;
+	LargeFileRun("/large", NumSectors * SectorSize * 3 / 4);
+
+	for (i = 1; i < FragFiles; i += 2) {
+		sprintf(name, "/frag%d", i);
+		fileSystem->Remove(name);
+	}
+	delete[] data;
+	printf("Large file test: %d ticks\n", stats->totalTicks - ticks);
+}
+
+//----------------------------------------------------------------------
+// InlineGrowTest
+// 	A file small enough to live in its header is appended to across the
+//	InlineSize boundary, in pieces that straddle it and that leave a
+//	hole, and read back.  The first write past InlineSize moves the
+//	contents to a data sector; nothing written before may get lost.
+//----------------------------------------------------------------------
+
+void InlineGrowTest() {
+	static int pieces[][2] = {	// 位置，长度
+		{ 0, InlineSize - 8 },		// 在文件头里
+		{ InlineSize - 8, 20 },		// 跨过InlineSize，内容搬到第0个扇区
+		{ InlineSize + 12, SectorSize },	// 跨过第0、1个扇区
+		{ 3 * SectorSize + 5, 10 },	// 中间留下空洞
+	};
+	int numPieces = sizeof(pieces) / sizeof(pieces[0]);
+	int length = 3 * SectorSize + 15;
+	char *buf = new char[length];
+	OpenFile *openFile;
+	bool ok = TRUE;
+	int i, j;
+
+	if (!fileSystem->Create("/inline", 0, TRUE)
+			|| (openFile = fileSystem->Open("/inline")) == NULL) {
+		printf("Inline grow test: can't create /inline\n");
+		delete[] buf;
+		return;
+	}
+	for (i = 0; i < numPieces && ok; i++) {
+		for (j = 0; j < pieces[i][1]; j++)
+			buf[j] = LargePattern(pieces[i][0] + j);
+		ok = (openFile->WriteAt(buf, pieces[i][1], pieces[i][0]) == pieces[i][1]);
+	}
+	ok = ok && openFile->Length() == length
+			&& openFile->ReadAt(buf, length, 0) == length;
+	for (j = 0; j < length && ok; j++) {
+		bool written = FALSE;
+		for (i = 0; i < numPieces; i++)
+			if (j >= pieces[i][0] && j < pieces[i][0] + pieces[i][1])
+				written = TRUE;
+		ok = (buf[j] == (written ? LargePattern(j) : 0));
+	}
+	printf("Inline grow test: %s\n", ok ? "ok" : "FAILED");
+	delete openFile;
+	fileSystem->Remove("/inline");
+	delete[] buf;
+}
+
+void testFileSystem() {
+   fileSystem->Create("/home", 0, FALSE);
+   fileSystem->Create("/tmp", 0, FALSE);
+   fileSystem->Create("/home/li", 0, FALSE);
+   // 测试程序相对于运行nachos的目录（filesys、vm等）
+   Copy("../test/thread1", "/home/li/thread1");
+   Copy("../test/thread2", "/home/li/thread2");
+   Copy("../test/sort", "/home/li/sort");
+   InlineGrowTest();
+//   Thread* t1 = new Thread("thread1");
+//   t1->Fork(testSynchRead, 0);
+////   Thread* t2 = new Thread("thread2");
+////   t2->Fork(testSynchRead, 0);
+//   Thread* t3 = new Thread("thrad3");
+//   t3->Fork(testSynchWrite, 0);
+//   DiskSchedTest();
+//   LargeFileTest();
+
+	/*
+//	 * pipe test
+//	 * */
+//	PipeFile* pipe = new PipeFile();
+//	Thread* write = new Thread("write");
+//	write->Fork(pipeWrite, (void*) pipe);
+//	Thread* read = new Thread("read");
+//	read->Fork(pipeRead, (void*) pipe);
+}
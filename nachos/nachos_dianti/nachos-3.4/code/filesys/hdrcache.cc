@@ -0,0 +1,210 @@
+// hdrcache.cc
+//	Routines to manage the file header cache.
+//
+//	读写文件头的磁盘操作在持有lock时进行（文件头的读写都经过缓冲区
+//	缓存，通常不会真正访问磁盘），所以同一个扇区不会被读入两次。
+//	被删除文件的文件头立即从散列表中摘下，扇区可以马上被重新分配，
+//	已经拿到它的线程用完后由Release/Discard释放。
+//
+// Copyright (c) 1992-1993 The Regents of the University of California.
+// All rights reserved.  See copyright.h for copyright notice and limitation
+// of liability and disclaimer of warranty provisions.
+
+#include "copyright.h"
+#include "hdrcache.h"
+#include "system.h"
+
+//----------------------------------------------------------------------
+// HeaderCache::HeaderCache
+// 	Initialize an empty cache that keeps up to "maxUnused" headers
+//	nobody is using.  Headers in use are never evicted, however many
+//	there are.
+//----------------------------------------------------------------------
+
+HeaderCache::HeaderCache(int maxUnused)
+{
+    size = maxUnused;
+    for (int i = 0; i < HeaderBuckets; i++)
+        buckets[i] = NULL;
+    numUnused = 0;
+    clock = 0;
+    numHits = numMisses = 0;
+    lock = new Lock("header cache lock");
+}
+
+HeaderCache::~HeaderCache()
+{
+    Flush();
+    for (int i = 0; i < HeaderBuckets; i++) {
+        while (buckets[i] != NULL) {
+            CachedHeader *entry = buckets[i];
+            buckets[i] = entry->hashNext;
+            delete entry->hdr;
+            delete entry;
+        }
+    }
+    delete lock;
+}
+
+CachedHeader *
+HeaderCache::lookup(int sector)
+{
+    for (CachedHeader *e = buckets[sector % HeaderBuckets]; e != NULL; e = e->hashNext)
+        if (e->sector == sector)
+            return e;
+    return NULL;
+}
+
+CachedHeader *
+HeaderCache::entryOf(FileHeader *hdr)
+{
+    ASSERT(hdr->cached != NULL);
+    return hdr->cached;
+}
+
+void
+HeaderCache::unlink(CachedHeader *entry)
+{
+    CachedHeader **p = &buckets[entry->sector % HeaderBuckets];
+
+    while (*p != entry)
+        p = &(*p)->hashNext;
+    *p = entry->hashNext;
+    entry->hashNext = NULL;
+}
+
+//----------------------------------------------------------------------
+// HeaderCache::Get
+// 	Return the header stored at "sector", reading it from disk only if
+//	it is not already cached.  "fill" is FALSE for a header that is
+//	about to be initialized by the caller (a new file).
+//----------------------------------------------------------------------
+
+FileHeader *
+HeaderCache::Get(int sector, bool fill)
+{
+    lock->Acquire();
+    CachedHeader *entry = lookup(sector);
+    if (entry != NULL) {
+        numHits++;
+        if (entry->refCount++ == 0)
+            numUnused--;
+    } else {
+        numMisses++;
+        entry = new CachedHeader;
+        entry->sector = sector;
+        entry->hdr = new FileHeader;
+        entry->hdr->cached = entry;
+        entry->refCount = 1;
+        entry->dirty = !fill;
+        entry->removed = FALSE;
+        entry->hashNext = buckets[sector % HeaderBuckets];
+        buckets[sector % HeaderBuckets] = entry;
+        if (fill)
+            entry->hdr->FetchFrom(sector);
+    }
+    entry->lastUsed = ++clock;
+    lock->Release();
+    return entry->hdr;
+}
+
+//----------------------------------------------------------------------
+// HeaderCache::Release
+// 	Drop one reference to "hdr".  The header stays cached; it is
+//	written back when it is evicted or flushed, if "dirty" (now or in
+//	an earlier call).
+//----------------------------------------------------------------------
+
+void
+HeaderCache::Release(FileHeader *hdr, bool dirty)
+{
+    lock->Acquire();
+    CachedHeader *entry = entryOf(hdr);
+    ASSERT(entry->refCount > 0);
+    if (dirty)
+        entry->dirty = TRUE;
+    if (--entry->refCount == 0) {
+        if (entry->removed) {
+            delete entry->hdr;
+            delete entry;
+        } else {
+            numUnused++;
+            evict();
+        }
+    }
+    lock->Release();
+}
+
+void
+HeaderCache::MarkDirty(FileHeader *hdr)
+{
+    lock->Acquire();
+    entryOf(hdr)->dirty = TRUE;
+    lock->Release();
+}
+
+//----------------------------------------------------------------------
+// HeaderCache::Discard
+// 	The file whose header is "hdr" has been deleted: take the header out
+//	of the cache without writing it back, so that its sector can be
+//	reused, and drop the caller's reference.  Other threads still
+//	holding the header can go on using it until they release it.
+//----------------------------------------------------------------------
+
+void
+HeaderCache::Discard(FileHeader *hdr)
+{
+    lock->Acquire();
+    CachedHeader *entry = entryOf(hdr);
+    if (!entry->removed) {
+        unlink(entry);
+        entry->removed = TRUE;
+    }
+    lock->Release();
+    Release(hdr, FALSE);
+}
+
+//----------------------------------------------------------------------
+// HeaderCache::evict
+// 	While more than "size" headers are unused, write back (if needed)
+//	and free the least recently used of them.
+//----------------------------------------------------------------------
+
+void
+HeaderCache::evict()
+{
+    while (numUnused > size) {
+        CachedHeader *victim = NULL;
+        for (int i = 0; i < HeaderBuckets; i++)
+            for (CachedHeader *e = buckets[i]; e != NULL; e = e->hashNext)
+                if (e->refCount == 0 && (victim == NULL || e->lastUsed < victim->lastUsed))
+                    victim = e;
+        ASSERT(victim != NULL);
+        if (victim->dirty)
+            victim->hdr->WriteBack(victim->sector);
+        unlink(victim);
+        numUnused--;
+        delete victim->hdr;
+        delete victim;
+    }
+}
+
+//----------------------------------------------------------------------
+// HeaderCache::Flush
+// 	Write back every header that is dirty.  Headers in use are written
+//	back too, since open files change their header (length, extents)
+//	without telling the cache until they are closed.
+//----------------------------------------------------------------------
+
+void
+HeaderCache::Flush()
+{
+    lock->Acquire();
+    for (int i = 0; i < HeaderBuckets; i++)
+        for (CachedHeader *e = buckets[i]; e != NULL; e = e->hashNext)
+            if (e->dirty || e->refCount > 0) {
+                e->hdr->WriteBack(e->sector);
+                e->dirty = FALSE;
+            }
+    lock->Release();
+}
@@ -0,0 +1,66 @@
+// hdrcache.h
+//	Data structures for the file header (i-node) cache.
+//
+//	内存中每个文件头只有一份：打开文件、目录、空闲位图文件都通过
+//	headerCache取得文件头并共享同一个FileHeader对象。没有人引用的
+//	文件头按LRU保留一段时间，再次打开时不用读盘；修改过的文件头在
+//	被替换或Flush时才写回。
+//
+// Copyright (c) 1992-1993 The Regents of the University of California.
+// All rights reserved.  See copyright.h for copyright notice and limitation
+// of liability and disclaimer of warranty provisions.
+
+#include "copyright.h"
+
+#ifndef HDRCACHE_H
+#define HDRCACHE_H
+
+#include "filehdr.h"
+#include "synch.h"
+
+#define HeaderCacheSize 64	// 保留的没有被引用的文件头数
+#define HeaderBuckets 64	// 散列桶数
+
+// 缓存中的一个文件头
+class CachedHeader {
+  public:
+    int sector;			// 文件头所在的扇区
+    FileHeader *hdr;
+    int refCount;		// 引用数，为0时可以被替换
+    bool dirty;			// 修改过，还没有写回
+    bool removed;		// 文件已经删除，最后一个引用释放时丢弃
+    int lastUsed;		// 最近一次被访问的时间，用于LRU
+    CachedHeader *hashNext;	// 同一个散列桶中的下一个
+};
+
+// The following class defines the file header cache.  Get returns a
+// header with its reference count raised; every Get is paired with a
+// Release (or Discard, when the file is being deleted).
+class HeaderCache {
+  public:
+    HeaderCache(int maxUnused);		// 保留maxUnused个没有被引用的文件头
+    ~HeaderCache();			// 写回所有修改过的文件头
+
+    FileHeader *Get(int sector, bool fill = TRUE); // fill为FALSE表示是新文件，
+					// 不从磁盘读入，调用者负责初始化
+    void Release(FileHeader *hdr, bool dirty); // 释放一个引用；dirty表示修改过
+    void MarkDirty(FileHeader *hdr);	// 文件头修改过，以后写回
+    void Discard(FileHeader *hdr);	// 文件已删除：释放引用，不写回
+    void Flush();			// 写回所有修改过的和正在使用的文件头
+
+    int numHits, numMisses;		// 统计
+
+  private:
+    CachedHeader *lookup(int sector);	// 必须持有lock
+    CachedHeader *entryOf(FileHeader *hdr); // 必须持有lock
+    void unlink(CachedHeader *entry);	// 从散列表中摘下
+    void evict();			// 没有被引用的文件头太多时替换最旧的
+
+    CachedHeader *buckets[HeaderBuckets];
+    int size;
+    int numUnused;			// 没有被引用的文件头数
+    int clock;
+    Lock *lock;
+};
+
+#endif // HDRCACHE_H
@@ -0,0 +1,462 @@
+// journal.cc
+//	Routines to manage the metadata journal.
+//
+//	日志区是一段连续的扇区，事务从头开始依次向后写：
+//
+//	  描述块 数据...  [描述块 数据...]  提交块 | 下一个事务 ...
+//
+//	提交时整个事务按顺序写入（描述块和数据一次写，提交块最后单独写），
+//	提交块写完事务才算完成。事务提交之前，它修改的扇区在缓冲区缓存中
+//	被hold住，不会写回原位置；提交之后由缓存像普通脏块一样写回。
+//	日志区写满时先把缓存全部写回（checkpoint），再从头开始写，
+//	超级块记录日志区开头的事务序号。
+//
+//	重放时从日志区开头读，序号连续、有提交块的事务才写回原位置；
+//	遇到序号不对或者没有提交块就停止（之后的内容是以前留下的）。
+//
+// Copyright (c) 1992-1993 The Regents of the University of California.
+// All rights reserved.  See copyright.h for copyright notice and limitation
+// of liability and disclaimer of warranty provisions.
+
+#include "copyright.h"
+#include "journal.h"
+#include "system.h"
+
+//----------------------------------------------------------------------
+// Journal::Journal
+// 	Create an inactive journal.  Nothing is logged until Format or
+//	Recover has found the journal area on disk.
+//----------------------------------------------------------------------
+
+Journal::Journal()
+{
+    active = FALSE;
+    suspended = FALSE;
+    superSector = -1;
+    head = 0;
+    sequence = 1;
+    records = NULL;
+    numRecords = 0;
+    maxRecords = 0;
+    logged = new BitMap(NumSectors);
+    inJournal = new BitMap(NumSectors);
+    txStart = 0;
+    activeOps = 0;
+    opThreads = new List();
+    committing = FALSE;
+    lock = new Lock("journal lock");
+    idle = new Condition("journal idle");
+    numCommits = numLogged = 0;
+}
+
+Journal::~Journal()
+{
+    Commit();
+    if (records != NULL)
+        delete [] records;
+    delete logged;
+    delete inJournal;
+    delete opThreads;
+    delete idle;
+    delete lock;
+}
+
+//----------------------------------------------------------------------
+// Journal::setLength
+// 	A transaction must fit in the journal area, descriptors and commit
+//	block included, and must leave JournalCacheSlack blocks of the
+//	buffer cache unheld.  Work out how many sectors one can log.
+//----------------------------------------------------------------------
+
+void
+Journal::setLength(int length)
+{
+    int cacheLimit = bufferCache->NumBlocks() - JournalCacheSlack;
+
+    maxRecords = length - 2;
+    while (maxRecords > 0
+            && divRoundUp(maxRecords, RecordsPerDesc) + maxRecords + 1 > length)
+        maxRecords--;
+    if (maxRecords > cacheLimit)
+        maxRecords = cacheLimit;
+    if (records != NULL)
+        delete [] records;
+    records = new int[maxRecords + 1];
+    numRecords = 0;
+}
+
+//----------------------------------------------------------------------
+// Journal::Format
+// 	Set up an empty journal in the "length" sectors from "start", with
+//	its superblock in "where", and start logging.
+//----------------------------------------------------------------------
+
+void
+Journal::Format(int where, int start, int length)
+{
+    char *zero = new char[SectorSize];
+
+    superSector = where;
+    super.magic = JournalSuperMagic;
+    super.start = start;
+    super.length = length;
+    super.sequence = sequence = 1;
+    head = 0;
+    bzero(zero, SectorSize);	// 日志区开头不能像一个事务
+    synchDisk->WriteSector(start, zero);
+    delete [] zero;
+    writeSuper();
+    setLength(length);
+    active = TRUE;
+    DEBUG('f', "Journal of %d sectors at sector %d.\n", length, start);
+}
+
+//----------------------------------------------------------------------
+// Journal::Recover
+// 	Read the superblock in "where" and replay every complete
+//	transaction in the journal, writing the logged sectors straight to
+//	their home locations.  Must run before anything else reads metadata.
+//	Return FALSE if there is no journal.
+//----------------------------------------------------------------------
+
+bool
+Journal::Recover(int where)
+{
+    char *buf = new char[SectorSize];
+    JournalDesc *desc = new JournalDesc;
+    int pos = 0, replayed = 0;
+
+    superSector = where;
+    synchDisk->ReadSector(superSector, buf);
+    bcopy(buf, (char *) &super, sizeof(JournalSuper));
+    if (super.magic != JournalSuperMagic || super.length <= 0) {
+        delete desc;
+        delete [] buf;
+        return FALSE;
+    }
+
+    sequence = super.sequence;
+    for (;;) {
+        // 先确认整个事务都在日志里，再写回原位置
+        int end = pos;
+        bool complete = FALSE;
+        while (end < super.length) {
+            synchDisk->ReadSector(super.start + end, (char *) desc);
+            if (desc->sequence != sequence)
+                break;
+            if (desc->magic == JournalCommitMagic) {
+                complete = (desc->count == end - pos + 1);
+                break;
+            }
+            if (desc->magic != JournalDescMagic || desc->count <= 0
+                    || desc->count > RecordsPerDesc
+                    || end + 1 + desc->count >= super.length)
+                break;
+            end += 1 + desc->count;
+        }
+        if (!complete)
+            break;
+
+        while (pos < end) {
+            synchDisk->ReadSector(super.start + pos, (char *) desc);
+            for (int i = 0; i < desc->count; i++) {
+                synchDisk->ReadSector(super.start + pos + 1 + i, buf);
+                synchDisk->WriteSector(desc->sectors[i], buf);
+            }
+            pos += 1 + desc->count;
+        }
+        pos++;			// 提交块
+        sequence++;
+        replayed++;
+    }
+    DEBUG('f', "Journal: replayed %d transactions.\n", replayed);
+
+    super.sequence = sequence;	// 重放的内容已经在原位置了
+    head = 0;
+    writeSuper();
+    setLength(super.length);
+    active = TRUE;
+    delete desc;
+    delete [] buf;
+    return TRUE;
+}
+
+//----------------------------------------------------------------------
+// Journal::Begin/End
+// 	Bracket one file system operation.  A commit waits until no
+//	operation is in progress, so it always sees whole operations.
+//	End commits the current transaction if it has grown big enough or
+//	old enough; otherwise it stays open to collect more operations.
+//
+//	A new operation does not join a transaction that already has
+//	JournalCommitRecords sectors: it commits it first if nothing else
+//	is running, or waits for the last running operation to do so.  So
+//	every operation starts with room for at least
+//	maxRecords - JournalCommitRecords sectors, and metadata never has
+//	to bypass the journal.  An operation nested inside one the same
+//	thread is running (a directory write that grows the file calls
+//	fillHole, say) is part of it and never waits.
+//----------------------------------------------------------------------
+
+bool
+Journal::nested()
+{
+    for (ListElement *e = opThreads->getHead(); e != NULL; e = e->next)
+        if (e->item == (void *) currentThread)
+            return TRUE;
+    return FALSE;
+}
+
+void
+Journal::Begin()
+{
+    lock->Acquire();
+    if (!nested()) {
+        while (committing || numRecords >= JournalCommitRecords) {
+            if (committing || activeOps > 0) {
+                idle->Wait(lock);
+                continue;
+            }
+            lock->Release();		// 两个操作之间，可以安全地提交
+            Commit();
+            lock->Acquire();
+        }
+    }
+    activeOps++;
+    opThreads->Prepend((void *) currentThread);
+    lock->Release();
+}
+
+void
+Journal::End()
+{
+    bool commit;
+
+    lock->Acquire();
+    ASSERT(activeOps > 0);
+    activeOps--;
+    opThreads->Remove((void *) currentThread);
+    commit = activeOps == 0 && numRecords > 0
+             && (numRecords >= JournalCommitRecords
+                 || stats->totalTicks - txStart > JournalMaxAge);
+    if (activeOps == 0)
+        idle->Broadcast(lock);
+    lock->Release();
+    if (commit)
+        Commit();
+}
+
+//----------------------------------------------------------------------
+// Journal::Log
+// 	"sector" has just been written into the buffer cache as part of a
+//	metadata change.  Add it to the current transaction (once), and
+//	keep the cache from writing it home until the transaction commits.
+//	Begin leaves every operation enough room (see CanLog for the one
+//	kind that can be bigger), so a full transaction is a bug.
+//----------------------------------------------------------------------
+
+void
+Journal::Log(int sector)
+{
+    if (!active)
+        return;
+    lock->Acquire();
+    if (!logged->Test(sector)) {
+        ASSERT(numRecords < maxRecords);	// 元数据不能绕过日志写回
+        if (numRecords == 0)
+            txStart = stats->totalTicks;
+        logged->Mark(sector);
+        if (!inJournal->Test(sector))
+            inJournal->Mark(sector);
+        records[numRecords++] = sector;
+        bufferCache->Hold(sector);
+    }
+    lock->Release();
+}
+
+//----------------------------------------------------------------------
+// Journal::CanLog
+// 	Will an operation that logs "sectors" sectors, besides the few any
+//	operation logs, always fit in the transaction it starts in?
+//	Directory::Add asks before doubling a directory, the only operation
+//	whose size grows with the file system; it stops growing the table
+//	instead of overflowing the journal.
+//----------------------------------------------------------------------
+
+bool
+Journal::CanLog(int sectors)
+{
+    return !active
+           || JournalCommitRecords + JournalOpSectors + sectors <= maxRecords;
+}
+
+//----------------------------------------------------------------------
+// Journal::Commit
+// 	Write the current transaction to the journal and let the buffer
+//	cache write its sectors home.  The sectors are copied out of the
+//	cache; operations that start meanwhile wait, metadata logged
+//	meanwhile goes into the next transaction.
+//
+//	"wait" -- FALSE if the caller cannot wait for running operations
+//	(the cache flusher): then nothing is committed if any are running.
+//----------------------------------------------------------------------
+
+void
+Journal::Commit(bool wait)
+{
+    lock->Acquire();
+    while (activeOps > 0 || committing) {
+        if (!wait) {
+            lock->Release();
+            return;
+        }
+        idle->Wait(lock);
+    }
+    if (!active || numRecords == 0) {
+        lock->Release();
+        return;
+    }
+    committing = TRUE;
+    int *list = records;
+    int count = numRecords;
+    records = new int[maxRecords + 1];
+    numRecords = 0;
+    for (int i = 0; i < count; i++)
+        logged->Clear(list[i]);
+    lock->Release();
+
+    int numDesc = divRoundUp(count, RecordsPerDesc);
+    int total = numDesc + count + 1;
+    ASSERT(total <= super.length);
+    if (head + total > super.length)
+        checkpoint(list, count);
+
+    char *buf = new char[total * SectorSize];
+    int pos = 0;
+    bzero(buf, total * SectorSize);
+    for (int i = 0; i < count; i += RecordsPerDesc) {
+        JournalDesc *desc = (JournalDesc *) (buf + pos * SectorSize);
+        int n = (count - i < RecordsPerDesc) ? count - i : RecordsPerDesc;
+        desc->magic = JournalDescMagic;
+        desc->sequence = sequence;
+        desc->count = n;
+        pos++;
+        for (int j = 0; j < n; j++, pos++) {
+            desc->sectors[j] = list[i + j];
+            bufferCache->ReadSector(list[i + j], buf + pos * SectorSize);
+        }
+    }
+    JournalDesc *done = (JournalDesc *) (buf + pos * SectorSize);
+    done->magic = JournalCommitMagic;
+    done->sequence = sequence;
+    done->count = total;
+
+    // 提交块之前的部分按顺序写，提交块最后写
+    for (int i = 0; i < total - 1; i += MaxDiskTransfer) {
+        int n = (total - 1 - i < MaxDiskTransfer) ? total - 1 - i : MaxDiskTransfer;
+        synchDisk->WriteSectors(super.start + head + i, n, buf + i * SectorSize);
+    }
+    synchDisk->WriteSector(super.start + head + total - 1, buf + pos * SectorSize);
+    DEBUG('f', "Journal: committed transaction %d, %d sectors.\n", sequence, count);
+    head += total;
+    sequence++;
+    numCommits++;
+    numLogged += count;
+
+    release(list, count);
+    delete [] list;
+    delete [] buf;
+
+    lock->Acquire();
+    committing = FALSE;
+    idle->Broadcast(lock);
+    lock->Release();
+}
+
+//----------------------------------------------------------------------
+// Journal::checkpoint
+// 	The journal area is full.  Everything committed so far is written
+//	home (the sectors of the transaction being committed, "list", are
+//	still held and stay in the cache), then the journal starts over.
+//----------------------------------------------------------------------
+
+void
+Journal::checkpoint(int *list, int count)
+{
+    bufferCache->Flush();
+    super.sequence = sequence;
+    head = 0;
+    writeSuper();
+    for (int i = 0; i < NumSectors; i++)
+        if (inJournal->Test(i))
+            inJournal->Clear(i);
+    for (int i = 0; i < count; i++)	// 正在提交的扇区马上又会写进日志
+        inJournal->Mark(list[i]);
+    lock->Acquire();
+    for (int i = 0; i < NumSectors; i++)
+        if (logged->Test(i))
+            inJournal->Mark(i);
+    lock->Release();
+}
+
+//----------------------------------------------------------------------
+// Journal::Suspend/Resume
+// 	Stop logging while the disk is bulk loaded (Import), and start
+//	again afterwards.  Everything logged so far is committed and
+//	checkpointed first, so the journal area is empty: replay after a
+//	crash can never write old metadata over sectors written meanwhile
+//	without the journal.  The caller makes sure nothing else is
+//	changing the file system while the journal is suspended.
+//----------------------------------------------------------------------
+
+void
+Journal::Suspend()
+{
+    Commit();
+    if (!active)
+        return;
+    checkpoint(NULL, 0);
+    active = FALSE;
+    suspended = TRUE;
+}
+
+void
+Journal::Resume()
+{
+    if (suspended) {
+        suspended = FALSE;
+        active = TRUE;
+    }
+}
+
+//----------------------------------------------------------------------
+// Journal::Contains
+// 	Is "sector" in the journal since the last checkpoint?  If it is,
+//	replay would write its old contents over anything written to it
+//	without the journal, so a data write to a sector that used to hold
+//	metadata (freed, then reused) has to be logged as well.
+//----------------------------------------------------------------------
+
+bool
+Journal::Contains(int sector)
+{
+    return active && inJournal->Test(sector);
+}
+
+void
+Journal::release(int *list, int count)
+{
+    for (int i = 0; i < count; i++)
+        bufferCache->Unhold(list[i]);
+}
+
+void
+Journal::writeSuper()
+{
+    char *buf = new char[SectorSize];
+
+    bzero(buf, SectorSize);
+    bcopy((char *) &super, buf, sizeof(JournalSuper));
+    synchDisk->WriteSector(superSector, buf);
+    delete [] buf;
+}
@@ -0,0 +1,106 @@
+// journal.h
+//	Data structures for the write-ahead journal of file system metadata.
+//
+//	元数据（文件头、间接块、目录、空闲位图）的修改先在缓冲区缓存中
+//	完成，同时记入当前事务；提交时把这些扇区的新内容连同描述块、提交块
+//	顺序写到磁盘上的日志区，之后缓存中的块才允许写回原来的位置。
+//	多个操作（Create、Remove、文件增长……）合在一个事务里一次提交
+//	（group commit）。挂载时重放日志中所有完整的事务。
+//
+// Copyright (c) 1992-1993 The Regents of the University of California.
+// All rights reserved.  See copyright.h for copyright notice and limitation
+// of liability and disclaimer of warranty provisions.
+
+#include "copyright.h"
+
+#ifndef JOURNAL_H
+#define JOURNAL_H
+
+#include "disk.h"
+#include "synch.h"
+#include "bitmap.h"
+
+#define JournalSuperMagic 0x4a726e6c	// 日志超级块
+#define JournalDescMagic 0x4a446573	// 描述块
+#define JournalCommitMagic 0x4a436d74	// 提交块
+#define JournalSize 64			// 日志区的扇区数
+#define JournalCommitRecords 16		// 事务中的扇区达到这么多时提交
+#define JournalOpSectors 8		// 一个普通操作最多记录的扇区数（目录扩大除外）
+#define JournalCacheSlack 4		// 事务最多hold住的块数比缓存少这么多
+#define JournalMaxAge 200000		// 事务开始超过这么多ticks后提交
+#define RecordsPerDesc ((int) (SectorSize / sizeof(int)) - 3) // 一个描述块记录的扇区数
+
+// 日志超级块，保存在空闲位图文件中位图之后的扇区里
+class JournalSuper {
+  public:
+    int magic;			// JournalSuperMagic
+    int start;			// 日志区的第一个扇区
+    int length;			// 日志区的扇区数
+    int sequence;		// 日志区开头的事务的序号
+};
+
+// 描述块：后面紧跟count个数据扇区，分别是sectors[]中扇区的新内容。
+// 一个事务由一个或多个描述块（及其数据）和一个提交块组成。
+class JournalDesc {
+  public:
+    int magic;			// JournalDescMagic或JournalCommitMagic
+    int sequence;		// 事务序号
+    int count;			// 描述块：数据扇区数；提交块：整个事务的扇区数
+    int sectors[RecordsPerDesc];
+};
+
+// The following class defines the journal.  Operations that change
+// metadata are bracketed by Begin/End so that a commit never splits
+// one; every metadata sector written into the buffer cache is reported
+// with Log.
+class Journal {
+  public:
+    Journal();
+    ~Journal();				// 提交还没有提交的修改
+
+    void Format(int where, int start, int length); // 建立空的日志，超级块在where扇区
+    bool Recover(int where);		// 读where扇区的超级块，重放完整的事务；
+					// 没有日志返回FALSE
+
+    void Begin();			// 开始一个操作
+    void End();				// 操作结束，可能触发提交
+    void Log(int sector);		// 扇区（已经写入缓冲区缓存）属于当前事务
+    void Commit(bool wait = TRUE);	// 提交当前事务；wait为FALSE时
+					// 如果有操作正在进行就不提交
+    bool Contains(int sector);		// 扇区在上次checkpoint之后写进过日志
+    bool CanLog(int sectors);		// 一个操作记录sectors个扇区是否放得进一个事务
+    void Suspend();			// 提交并checkpoint，之后不再记录（批量装载）
+    void Resume();			// Suspend之后重新开始记录
+
+    int numCommits;			// 统计：提交次数
+    int numLogged;			// 统计：写入日志的扇区数
+
+  private:
+    bool nested();			// 当前线程已经在一个操作中
+    void writeSuper();			// 直接写盘，不经过缓存
+    void checkpoint(int *list, int count); // 把已提交的修改写回原位置，清空日志区
+    void release(int *list, int count);	// 允许缓存写回这些扇区
+    void setLength(int length);		// 根据日志区大小计算maxRecords
+
+    bool active;			// Format或Recover之后才记录
+    bool suspended;			// 被Suspend停止记录
+    int superSector;
+    JournalSuper super;
+    int head;				// 下一个事务写在日志区中的位置
+    int sequence;			// 下一个事务的序号
+
+    int *records;			// 当前事务的扇区
+    int numRecords;
+    int maxRecords;			// 一个事务最多记录的扇区数
+    BitMap *logged;			// 扇区是否已经在当前事务中
+    BitMap *inJournal;			// 上次checkpoint之后写进日志的扇区
+    int txStart;			// 当前事务第一次Log的时间
+
+    int activeOps;			// 正在进行的操作数（包括嵌套的）
+    List *opThreads;			// 每个进行中的操作一项：执行它的线程
+    bool committing;
+    Lock *lock;
+    Condition *idle;			// 没有操作在进行、没有在提交时广播
+};
+
+#endif // JOURNAL_H
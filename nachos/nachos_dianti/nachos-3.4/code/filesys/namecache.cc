@@ -0,0 +1,160 @@
+// namecache.cc
+//	Routines to manage the path-name lookup cache.
+//
+//	表项按(parent, name)散列，桶数和表项数相同。缓存满时替换最久
+//	没有使用的项。名字超过FileNameMaxLen的文件不缓存。
+//
+// Copyright (c) 1992-1993 The Regents of the University of California.
+// All rights reserved.  See copyright.h for copyright notice and limitation
+// of liability and disclaimer of warranty provisions.
+
+#include "copyright.h"
+#include "namecache.h"
+#include "system.h"
+
+//----------------------------------------------------------------------
+// NameCache::NameCache
+// 	Initialize an empty cache of "size" names.
+//----------------------------------------------------------------------
+
+NameCache::NameCache(int size)
+{
+    ASSERT(size > 0);
+    numEntries = size;
+    entries = new NameEntry[numEntries];
+    buckets = new int[numEntries];
+    for (int i = 0; i < numEntries; i++) {
+        entries[i].parent = -1;
+        entries[i].name[0] = '\0';
+        entries[i].child = NameNotFound;
+        entries[i].lastUsed = 0;
+        entries[i].hashNext = -1;
+        buckets[i] = -1;
+    }
+    clock = 0;
+    numHits = numMisses = 0;
+}
+
+NameCache::~NameCache()
+{
+    delete [] buckets;
+    delete [] entries;
+}
+
+unsigned int
+NameCache::bucket(int parent, char *name)
+{
+    unsigned int h = (unsigned int) parent;
+    for (int i = 0; i < FileNameMaxLen && name[i] != '\0'; i++)
+        h = h * 33 + (unsigned char) name[i];
+    return h % numEntries;
+}
+
+int
+NameCache::find(int parent, char *name)
+{
+    for (int i = buckets[bucket(parent, name)]; i != -1; i = entries[i].hashNext)
+        if (entries[i].parent == parent && !strcmp(entries[i].name, name))
+            return i;
+    return -1;
+}
+
+void
+NameCache::unlink(int i)
+{
+    int *p = &buckets[bucket(entries[i].parent, entries[i].name)];
+
+    while (*p != i)
+        p = &entries[*p].hashNext;
+    *p = entries[i].hashNext;
+    entries[i].parent = -1;
+    entries[i].hashNext = -1;
+}
+
+//----------------------------------------------------------------------
+// NameCache::Lookup
+// 	Look up "name" in the directory whose header is at "parent".
+//	Return FALSE on a miss; on a hit return TRUE and put the sector
+//	of the file's header, or NameNotFound, in "*child".
+//----------------------------------------------------------------------
+
+bool
+NameCache::Lookup(int parent, char *name, int *child)
+{
+    int i = (strlen(name) > FileNameMaxLen) ? -1 : find(parent, name);
+
+    if (i == -1) {
+        numMisses++;
+        return FALSE;
+    }
+    numHits++;
+    entries[i].lastUsed = ++clock;
+    *child = entries[i].child;
+    return TRUE;
+}
+
+//----------------------------------------------------------------------
+// NameCache::Enter
+// 	Remember that "name" in directory "parent" is the file whose header
+//	is at "child" (NameNotFound: there is no such file).  Replaces any
+//	entry already there.
+//----------------------------------------------------------------------
+
+void
+NameCache::Enter(int parent, char *name, int child)
+{
+    if (strlen(name) > FileNameMaxLen)
+        return;
+    int i = find(parent, name);
+    if (i == -1) {
+        i = 0;
+        for (int j = 0; j < numEntries; j++) {  // 空闲的项或者最久没有使用的项
+            if (entries[j].parent == -1) {
+                i = j;
+                break;
+            }
+            if (entries[j].lastUsed < entries[i].lastUsed)
+                i = j;
+        }
+        if (entries[i].parent != -1)
+            unlink(i);
+        entries[i].parent = parent;
+        strncpy(entries[i].name, name, FileNameMaxLen);
+        entries[i].name[FileNameMaxLen] = '\0';
+        unsigned int b = bucket(parent, entries[i].name);
+        entries[i].hashNext = buckets[b];
+        buckets[b] = i;
+    }
+    entries[i].child = child;
+    entries[i].lastUsed = ++clock;
+}
+
+//----------------------------------------------------------------------
+// NameCache::Remove
+// 	Forget what is known about "name" in directory "parent".
+//----------------------------------------------------------------------
+
+void
+NameCache::Remove(int parent, char *name)
+{
+    int i = (strlen(name) > FileNameMaxLen) ? -1 : find(parent, name);
+
+    if (i != -1)
+        unlink(i);
+}
+
+//----------------------------------------------------------------------
+// NameCache::Purge
+// 	Forget every entry that leads to, or goes through, the file whose
+//	header is at "sector".  Used when a file is deleted and only its
+//	header sector is known; the sector may be reused for a new file.
+//----------------------------------------------------------------------
+
+void
+NameCache::Purge(int sector)
+{
+    for (int i = 0; i < numEntries; i++)
+        if (entries[i].parent != -1
+                && (entries[i].child == sector || entries[i].parent == sector))
+            unlink(i);
+}
@@ -0,0 +1,60 @@
+// namecache.h
+//	Data structures for the path-name lookup cache.
+//
+//	缓存目录查找的结果：(父目录文件头扇区, 文件名) -> 文件头扇区。
+//	找不到的名字也缓存（负项），这样反复查找不存在的文件也不用读目录。
+//	文件系统在创建、删除文件时更新缓存。
+//
+// Copyright (c) 1992-1993 The Regents of the University of California.
+// All rights reserved.  See copyright.h for copyright notice and limitation
+// of liability and disclaimer of warranty provisions.
+
+#include "copyright.h"
+
+#ifndef NAMECACHE_H
+#define NAMECACHE_H
+
+#include "directory.h"
+
+#define NameCacheSize 128   // 缓存的表项数
+#define NameNotFound (-1)   // 负项的child
+
+// 缓存中的一项
+class NameEntry {
+  public:
+    int parent;				// 父目录的文件头扇区，-1表示空闲
+    char name[FileNameMaxLen + 1];
+    int child;				// 文件头扇区，NameNotFound表示不存在
+    int lastUsed;			// 最近一次被访问的时间，用于LRU
+    int hashNext;			// 同一个散列桶中的下一项，-1表示结束
+};
+
+// The following class defines the name cache.  Like Directory, it
+// assumes mutual exclusion is provided by the caller; none of its
+// operations block.
+class NameCache {
+  public:
+    NameCache(int size);
+    ~NameCache();
+
+    bool Lookup(int parent, char *name, int *child); // 命中时返回TRUE，
+					// *child为文件头扇区或NameNotFound
+    void Enter(int parent, char *name, int child); // 记录查找结果，
+					// child为NameNotFound表示不存在
+    void Remove(int parent, char *name); // 删除一项
+    void Purge(int sector);		// 删除所有指向sector或以sector为父目录的项
+
+    int numHits, numMisses;		// 统计
+
+  private:
+    int find(int parent, char *name);	// 返回表项下标，-1表示不在缓存中
+    unsigned int bucket(int parent, char *name);
+    void unlink(int i);			// 从散列表中摘下表项i并置为空闲
+
+    NameEntry *entries;
+    int numEntries;
+    int *buckets;			// 值为entries的下标
+    int clock;
+};
+
+#endif // NAMECACHE_H
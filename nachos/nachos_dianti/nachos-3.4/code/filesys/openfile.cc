@@ -1,244 +1,425 @@
-// openfile.cc
-//	Routines to manage an open Nachos file.  As in UNIX, a
-//	file must be open before we can read or write to it.
-//	Once we're all done, we can close it (in Nachos, by deleting
-//	the OpenFile data structure).
-//
-//	Also as in UNIX, for convenience, we keep the file header in
-//	memory while the file is open.
-//
-// Copyright (c) 1992-1993 The Regents of the University of California.
-// All rights reserved.  See copyright.h for copyright notice and limitation
-// of liability and disclaimer of warranty provisions.
-
-#include "copyright.h"
-#include "filehdr.h"
-#include "openfile.h"
-#include "system.h"
-#ifdef HOST_SPARC
-#include <strings.h>
-#endif
-
-//----------------------------------------------------------------------
-// OpenFile::OpenFile
-// 	Open a Nachos file for reading and writing.  Bring the file header
-//	into memory while the file is open.
-//
-//	"sector" -- the location on disk of the file header for this file
-//----------------------------------------------------------------------
-
-OpenFile::OpenFile(int sector)
-{
-    hdr = new FileHeader;
-    hdr->FetchFrom(sector);
-    seekPosition = 0;
-    filesys = 0;
-}
-
-//----------------------------------------------------------------------
-// OpenFile::~OpenFile
-// 	Close a Nachos file, de-allocating any in-memory data structures.
-//----------------------------------------------------------------------
-
-OpenFile::~OpenFile()
-{
-    delete hdr;
-}
-
-//----------------------------------------------------------------------
-// OpenFile::Seek
-// 	Change the current location within the open file -- the point at
-//	which the next Read or Write will start from.
-//
-//	"position" -- the location within the file for the next Read/Write
-//----------------------------------------------------------------------
-
-void OpenFile::Seek(int position)
-{
-    seekPosition = position;
-}
-
-//----------------------------------------------------------------------
-// OpenFile::Read/Write
-// 	Read/write a portion of a file, starting from seekPosition.
-//	Return the number of bytes actually written or read, and as a
-//	side effect, increment the current position within the file.
-//
-//	Implemented using the more primitive ReadAt/WriteAt.
-//
-//	"into" -- the buffer to contain the data to be read from disk
-//	"from" -- the buffer containing the data to be written to disk
-//	"numBytes" -- the number of bytes to transfer
-//----------------------------------------------------------------------
-
-int OpenFile::Read(char *into, int numBytes)
-{
-    int result = ReadAt(into, numBytes, seekPosition);
-    seekPosition += result;
-    return result;
-}
-
-int OpenFile::Write(char *into, int numBytes)
-{
-    int result = WriteAt(into, numBytes, seekPosition);
-    seekPosition += result;
-    return result;
-}
-
-//----------------------------------------------------------------------
-// OpenFile::ReadAt/WriteAt
-// 	Read/write a portion of a file, starting at "position".
-//	Return the number of bytes actually written or read, but has
-//	no side effects (except that Write modifies the file, of course).
-//
-//	There is no guarantee the request starts or ends on an even disk sector
-//	boundary; however the disk only knows how to read/write a whole disk
-//	sector at a time.  Thus:
-//
-//	For ReadAt:
-//	   We read in all of the full or partial sectors that are part of the
-//	   request, but we only copy the part we are interested in.
-//	For WriteAt:
-//	   We must first read in any sectors that will be partially written,
-//	   so that we don't overwrite the unmodified portion.  We then copy
-//	   in the data that will be modified, and write back all the full
-//	   or partial sectors that are part of the request.
-//
-//	"into" -- the buffer to contain the data to be read from disk
-//	"from" -- the buffer containing the data to be written to disk
-//	"numBytes" -- the number of bytes to transfer
-//	"position" -- the offset within the file of the first byte to be
-//			read/written
-//----------------------------------------------------------------------
-
-int OpenFile::ReadAt(char *into, int numBytes, int position)
-{
-    int fileLength = hdr->FileLength();
-    int i, firstSector, lastSector, numSectors;
-    char *buf;
-
-    if ((numBytes <= 0) || (position >= fileLength))
-        return 0; // check request
-    if ((position + numBytes) > fileLength)
-        numBytes = fileLength - position;
-    DEBUG('f', "Reading %d bytes at %d, from file of length %d.\n",
-          numBytes, position, fileLength);
-
-    firstSector = divRoundDown(position, SectorSize);
-    lastSector = divRoundDown(position + numBytes - 1, SectorSize);
-    numSectors = 1 + lastSector - firstSector;
-
-    // read in all the full and partial sectors that we need
-    buf = new char[numSectors * SectorSize];
-
-    for (i = firstSector; i <= lastSector; i++)
-    {
-        synchDisk->ReadSector(hdr->ByteToSector(i * SectorSize, this->filesys),
-                              &buf[(i - firstSector) * SectorSize]);
-    }
-
-    // copy the part we want
-    bcopy(&buf[position - (firstSector * SectorSize)], into, numBytes);
-    delete[] buf;
-    return numBytes;
-}
-
-int OpenFile::WriteAt(char *from, int numBytes, int position)
-{
-    int fileLength = hdr->FileLength();
-    int i, firstSector, lastSector, numSectors;
-    bool firstAligned, lastAligned;
-    char *buf;
-
-    if ((numBytes <= 0))
-        return 0; // check request
-    if ((position + numBytes) > fileLength)
-    {
-        hdr->setFileLength(position + numBytes);
-    }
-
-    DEBUG('f', "Writing %d bytes at %d, into file, original length is %d.\n",
-          numBytes, position, fileLength);
-
-    firstSector = divRoundDown(position, SectorSize);
-    lastSector = divRoundDown(position + numBytes - 1, SectorSize);
-    numSectors = 1 + lastSector - firstSector;
-
-    buf = new char[numSectors * SectorSize];
-
-    firstAligned = (position == (firstSector * SectorSize));
-    lastAligned = ((position + numBytes) == ((lastSector + 1) * SectorSize));
-
-    // read in first and last sector, if they are to be partially modified
-    if (!firstAligned)
-        ReadAt(buf, SectorSize, firstSector * SectorSize);
-    if (!lastAligned && ((firstSector != lastSector) || firstAligned))
-        ReadAt(&buf[(lastSector - firstSector) * SectorSize],
-               SectorSize, lastSector * SectorSize);
-
-    // copy in the bytes we want to change
-    bcopy(from, &buf[position - (firstSector * SectorSize)], numBytes);
-
-    // write modified sectors back
-    for (i = firstSector; i <= lastSector; i++)
-    {
-        synchDisk->WriteSector(hdr->ByteToSector(i * SectorSize, filesys),
-                               &buf[(i - firstSector) * SectorSize]);
-    }
-    delete[] buf;
-
-    return numBytes;
-}
-
-//----------------------------------------------------------------------
-// OpenFile::Length
-// 	Return the number of bytes in the file.
-//----------------------------------------------------------------------
-
-int OpenFile::Length()
-{
-    return hdr->FileLength();
-}
-
-/*
- * pipefile class member func definion
- *
- * */
-PipeFile::PipeFile(){
-	readPossion = 0;
-	writePossion = 0;
-	bufLen = 0;
-	buffer = new char[4096];
-}
-
-int PipeFile::read(char* buf, int numBytes){
-	int count = 0;
-	if(numBytes + readPossion > bufLen){
-		count = bufLen - readPossion;
-	}else{
-		count = numBytes;
-	}
-	strncpy(buf, buffer + readPossion, count);
-	readPossion += count;
-	bufLen -= count;
-
-	char* newBuf = new char[4096];
-	strncpy(newBuf, buffer + readPossion, bufLen);
-	delete buffer;
-	buffer = newBuf;
-
-	return count;
-}
-int PipeFile::write(char* buf, int numBytes){
-	int count = 0;
-	if(writePossion + numBytes > 4096){
-		count = 4096 - writePossion;
-	}else{
-		count = numBytes;
-	}
-	strncpy(buffer+writePossion, buf, count);
-	writePossion += count;
-	bufLen += count;
-	return count;
-
-}
+// openfile.cc
+//	Routines to manage an open Nachos file.  As in UNIX, a
+//	file must be open before we can read or write to it.
+//	Once we're all done, we can close it (in Nachos, by deleting
+//	the OpenFile data structure).
+//
+//	Also as in UNIX, for convenience, we keep the file header in
+//	memory while the file is open.
+//
+// Copyright (c) 1992-1993 The Regents of the University of California.
+// All rights reserved.  See copyright.h for copyright notice and limitation
+// of liability and disclaimer of warranty provisions.
+
+#include "copyright.h"
+#include "filehdr.h"
+#include "openfile.h"
+#include "filesys.h"
+#include "system.h"
+#ifdef HOST_SPARC
+#include <strings.h>
+#endif
+
+//----------------------------------------------------------------------
+// OpenFile::OpenFile
+// 	Open a Nachos file for reading and writing.  Bring the file header
+//	into memory while the file is open.
+//
+//	"sector" -- the location on disk of the file header for this file
+//	文件头从headerCache中取得，和其他打开者共享。
+//----------------------------------------------------------------------
+
+OpenFile::OpenFile(int sector)
+{
+    hdr = headerCache->Get(sector);
+    hdrSector = sector;
+    hdrDirty = FALSE;
+    journaled = FALSE;
+    seekPosition = 0;
+    filesys = 0;
+    entry = 0;
+    seqPosition = 0;
+    raWindow = 0;
+    raLimit = 0;
+}
+
+//----------------------------------------------------------------------
+// OpenFile::~OpenFile
+// 	Close a Nachos file, de-allocating any in-memory data structures.
+//----------------------------------------------------------------------
+
+OpenFile::~OpenFile()
+{
+    if (entry != 0) // 文件头属于系统打开文件表
+        filesys->releaseEntry(entry);
+    else
+        headerCache->Release(hdr, hdrDirty);
+}
+
+//----------------------------------------------------------------------
+// OpenFile::Seek
+// 	Change the current location within the open file -- the point at
+//	which the next Read or Write will start from.
+//
+//	"position" -- the location within the file for the next Read/Write
+//----------------------------------------------------------------------
+
+void OpenFile::Seek(int position)
+{
+    seekPosition = position;
+}
+
+//----------------------------------------------------------------------
+// OpenFile::Read/Write
+// 	Read/write a portion of a file, starting from seekPosition.
+//	Return the number of bytes actually written or read, and as a
+//	side effect, increment the current position within the file.
+//
+//	Implemented using the more primitive ReadAt/WriteAt.
+//
+//	"into" -- the buffer to contain the data to be read from disk
+//	"from" -- the buffer containing the data to be written to disk
+//	"numBytes" -- the number of bytes to transfer
+//----------------------------------------------------------------------
+
+int OpenFile::Read(char *into, int numBytes)
+{
+    int result = ReadAt(into, numBytes, seekPosition);
+    seekPosition += result;
+    return result;
+}
+
+int OpenFile::Write(char *into, int numBytes)
+{
+    int result = WriteAt(into, numBytes, seekPosition);
+    seekPosition += result;
+    return result;
+}
+
+//----------------------------------------------------------------------
+// OpenFile::ReadAt/WriteAt
+// 	Read/write a portion of a file, starting at "position".
+//	Return the number of bytes actually written or read, but has
+//	no side effects (except that Write modifies the file, of course).
+//
+//	There is no guarantee the request starts or ends on an even disk sector
+//	boundary; however the disk only knows how to read/write a whole disk
+//	sector at a time.  Thus:
+//
+//	For ReadAt:
+//	   We read in all of the full or partial sectors that are part of the
+//	   request, but we only copy the part we are interested in.
+//	For WriteAt:
+//	   We must first read in any sectors that will be partially written,
+//	   so that we don't overwrite the unmodified portion.  We then copy
+//	   in the data that will be modified, and write back all the full
+//	   or partial sectors that are part of the request.
+//
+//	"into" -- the buffer to contain the data to be read from disk
+//	"from" -- the buffer containing the data to be written to disk
+//	"numBytes" -- the number of bytes to transfer
+//	"position" -- the offset within the file of the first byte to be
+//			read/written
+//
+//	磁盘满了分配不到扇区时WriteAt停下来，返回已经写入的字节数，
+//	文件长度也只算到那里。
+//----------------------------------------------------------------------
+
+int OpenFile::ReadAt(char *into, int numBytes, int position)
+{
+    int fileLength = hdr->FileLength();
+    int i, firstSector, lastSector;
+
+    if ((numBytes <= 0) || (position >= fileLength))
+        return 0; // check request
+    if ((position + numBytes) > fileLength)
+        numBytes = fileLength - position;
+    DEBUG('f', "Reading %d bytes at %d, from file of length %d.\n",
+          numBytes, position, fileLength);
+    if (hdr->IsInline()) {      // 小文件，内容就在文件头里
+        hdr->ReadInline(into, numBytes, position);
+        return numBytes;
+    }
+
+    firstSector = divRoundDown(position, SectorSize);
+    lastSector = divRoundDown(position + numBytes - 1, SectorSize);
+
+    // copy the part we want straight out of the buffer cache, one
+    // full or partial sector at a time.  Every track's worth of sectors,
+    // first start reading all the ones that are not cached yet, so that
+    // consecutive sectors go to the disk as one multi-sector request
+    // instead of one request (and one rotational delay) each.
+    // Holes are not on disk at all and read as zeros.
+    for (i = firstSector; i <= lastSector; i++)
+    {
+        if (lastSector > firstSector && (i - firstSector) % SectorsPerTrack == 0)
+            for (int j = i; j <= lastSector && j < i + SectorsPerTrack; j++) {
+                int s = hdr->Lookup(j * SectorSize);
+                if (s != -1)
+                    bufferCache->StartRead(s);
+            }
+        int start = (i == firstSector) ? position : i * SectorSize;
+        int end = (i == lastSector) ? position + numBytes : (i + 1) * SectorSize;
+        int sector = hdr->Lookup(i * SectorSize);
+        if (sector == -1) {
+            bzero(into + (start - position), end - start);
+            continue;
+        }
+        char *cached = bufferCache->Pin(sector, TRUE);
+        bcopy(cached + (start - i * SectorSize), into + (start - position),
+              end - start);
+        bufferCache->Unpin(sector, FALSE);
+    }
+    readAhead(position, numBytes);
+    return numBytes;
+}
+
+//----------------------------------------------------------------------
+// OpenFile::readAhead
+// 	Sequential access detection.  A read that starts where the previous
+//	one ended doubles the read-ahead window (up to MaxReadAhead sectors);
+//	any other read resets it.  The sectors in the window after the data
+//	just read are handed to the buffer cache to be prefetched, so the
+//	next sequential read finds them already in memory.
+//----------------------------------------------------------------------
+
+void
+OpenFile::readAhead(int position, int numBytes)
+{
+    int nextSector = divRoundUp(position + numBytes, SectorSize);
+    int fileSectors = divRoundUp(hdr->FileLength(), SectorSize);
+
+    if (position == seqPosition) {
+        raWindow = (raWindow == 0) ? MinReadAhead : raWindow * 2;
+        if (raWindow > MaxReadAhead)
+            raWindow = MaxReadAhead;
+    } else {
+        raWindow = 0;
+        raLimit = 0;
+    }
+    seqPosition = position + numBytes;
+
+    if (raLimit < nextSector)
+        raLimit = nextSector;
+    int end = nextSector + raWindow;
+    if (end > fileSectors)
+        end = fileSectors;
+    for (; raLimit < end; raLimit++) {
+        int sector = hdr->Lookup(raLimit * SectorSize);
+        if (sector != -1)
+            bufferCache->Prefetch(sector);
+    }
+}
+
+int OpenFile::WriteAt(char *from, int numBytes, int position)
+{
+    int fileLength = hdr->FileLength();
+    int i, firstSector, lastSector;
+    bool wasInline;
+
+    if ((numBytes <= 0))
+        return 0; // check request
+    hdrDirty = TRUE; // 长度或extent可能会变
+    if (entry != 0)
+        entry->hdrDirty = TRUE; // 最后一次关闭时写回文件头
+    if (hdr->IsInline() && position + numBytes <= InlineSize)
+    {
+        hdr->WriteInline(from, numBytes, position);
+        if (journaled && hdrSector != -1)       // 内容在文件头里，文件头也要记入日志
+            hdr->WriteBack(hdrSector);
+        return numBytes;
+    }
+    if (position > fileLength)
+        zeroGap(fileLength, position);
+    if ((position + numBytes) > fileLength)
+    {
+        hdr->setFileLength(position + numBytes);
+    }
+
+    DEBUG('f', "Writing %d bytes at %d, into file, original length is %d.\n",
+          numBytes, position, fileLength);
+
+    firstSector = divRoundDown(position, SectorSize);
+    lastSector = divRoundDown(position + numBytes - 1, SectorSize);
+    wasInline = hdr->IsInline(); // 第一次ByteToSector会把内容搬到第0个扇区
+
+    // modify the cached copy of each sector in place.  Only sectors that
+    // are partially modified (and already part of the file, not a hole)
+    // need to be read in first; fully overwritten sectors are never read.
+    for (i = firstSector; i <= lastSector; i++)
+    {
+        int start = (i == firstSector) ? position : i * SectorSize;
+        int end = (i == lastSector) ? position + numBytes : (i + 1) * SectorSize;
+        bool partial = (end - start) < SectorSize && i * SectorSize < fileLength
+                       && ((wasInline && i == 0) || hdr->Lookup(i * SectorSize) != -1);
+        // 不在系统打开文件表中的文件（目录、位图）没有最后一次关闭时的Trim，
+        // 所以不预分配扇区
+        int sector = hdr->ByteToSector(i * SectorSize, filesys, entry != 0,
+                                       headerSector());
+        if (sector == -1) {     // 磁盘满了
+            int done = start - position;
+            hdr->setFileLength((position + done > fileLength) ? position + done
+                                                              : fileLength);
+            return done;
+        }
+        char *cached = bufferCache->Pin(sector, partial);
+        if (!partial && (end - start) < SectorSize)
+            bzero(cached, SectorSize); // 新分配的扇区
+        bcopy(from + (start - position), cached + (start - i * SectorSize),
+              end - start);
+        bufferCache->Unpin(sector, TRUE);
+        if (journaled || journal->Contains(sector))
+            journal->Log(sector);
+    }
+
+    return numBytes;
+}
+
+//----------------------------------------------------------------------
+// OpenFile::zeroGap
+// 	A write past the end of the file leaves a gap from the old end
+//	"from" to the write at "to".  Unallocated parts of it are holes and
+//	already read as zeros; what is allocated -- the rest of the last
+//	sector, and sectors preallocated past the end -- may hold old data
+//	and is cleared here.
+//----------------------------------------------------------------------
+
+void
+OpenFile::zeroGap(int from, int to)
+{
+    for (int i = divRoundDown(from, SectorSize); i * SectorSize < to; i++) {
+        int sector = hdr->Lookup(i * SectorSize);
+        if (sector == -1) {
+            if (hdr->IsInline())
+                return;
+            continue;
+        }
+        int start = (i * SectorSize > from) ? i * SectorSize : from;
+        int end = ((i + 1) * SectorSize < to) ? (i + 1) * SectorSize : to;
+        bool partial = start > i * SectorSize || end < (i + 1) * SectorSize;
+        char *cached = bufferCache->Pin(sector, partial);
+        bzero(cached + (start - i * SectorSize), end - start);
+        bufferCache->Unpin(sector, TRUE);
+        if (journaled || journal->Contains(sector))
+            journal->Log(sector);
+    }
+}
+
+//----------------------------------------------------------------------
+// OpenFile::headerSector
+// 	The sector of this file's header: files in the open-file table
+//	share the header of their entry, the others know their own.
+//----------------------------------------------------------------------
+
+int
+OpenFile::headerSector()
+{
+    return (entry != 0) ? entry->headSec : hdrSector;
+}
+
+//----------------------------------------------------------------------
+// OpenFile::Length
+// 	Return the number of bytes in the file.
+//----------------------------------------------------------------------
+
+int OpenFile::Length()
+{
+    return hdr->FileLength();
+}
+
+//----------------------------------------------------------------------
+// OpenFile::ReadPage/WritePage
+// 	内存映射文件的缺页处理和脏页写回。页面大小等于扇区大小，
+//	所以一个页面正好对应文件的一个扇区，通过ByteToSector直接找到扇区，
+//	省去ReadAt/WriteAt的中间缓冲区拷贝。
+//	超过文件末尾的部分读出为0，写回时忽略（不会改变文件长度）。
+//
+//	"position" -- 页面在文件中的偏移，按SectorSize对齐
+//----------------------------------------------------------------------
+
+void OpenFile::ReadPage(char *into, int position)
+{
+    int fileLength = hdr->FileLength();
+
+    ASSERT(position % SectorSize == 0);
+    if (position >= fileLength) {
+        bzero(into, SectorSize);
+        return;
+    }
+    if (hdr->IsInline()) {
+        bzero(into, SectorSize);
+        hdr->ReadInline(into, fileLength - position, position);
+        return;
+    }
+    int sector = hdr->Lookup(position);
+    if (sector == -1) {         // 空洞
+        bzero(into, SectorSize);
+        return;
+    }
+    bufferCache->ReadSector(sector, into);
+    if (position + SectorSize > fileLength)
+        bzero(into + (fileLength - position), position + SectorSize - fileLength);
+}
+
+void OpenFile::WritePage(char *from, int position)
+{
+    ASSERT(position % SectorSize == 0);
+    if (position >= hdr->FileLength())
+        return;
+    hdrDirty = TRUE;
+    if (entry != 0)
+        entry->hdrDirty = TRUE;
+    if (hdr->IsInline()) {      // 只写回文件长度以内的部分
+        hdr->WriteInline(from, hdr->FileLength() - position, position);
+        return;
+    }
+    int sector = hdr->ByteToSector(position, filesys, entry != 0, headerSector());
+    if (sector == -1)           // 磁盘满了，这一页的修改只能丢掉
+        return;
+    bufferCache->WriteSector(sector, from);
+    if (journal->Contains(sector))
+        journal->Log(sector);
+}
+
+/*
+ * pipefile class member func definion
+ *
+ * */
+PipeFile::PipeFile(){
+	readPossion = 0;
+	writePossion = 0;
+	bufLen = 0;
+	buffer = new char[4096];
+}
+
+int PipeFile::read(char* buf, int numBytes){
+	int count = 0;
+	if(numBytes + readPossion > bufLen){
+		count = bufLen - readPossion;
+	}else{
+		count = numBytes;
+	}
+	strncpy(buf, buffer + readPossion, count);
+	readPossion += count;
+	bufLen -= count;
+
+	char* newBuf = new char[4096];
+	strncpy(newBuf, buffer + readPossion, bufLen);
+	delete buffer;
+	buffer = newBuf;
+
+	return count;
+}
+int PipeFile::write(char* buf, int numBytes){
+	int count = 0;
+	if(writePossion + numBytes > 4096){
+		count = 4096 - writePossion;
+	}else{
+		count = numBytes;
+	}
+	strncpy(buffer+writePossion, buf, count);
+	writePossion += count;
+	bufLen += count;
+	return count;
+
+}
@@ -1,130 +1,173 @@
-// openfile.h
-//	Data structures for opening, closing, reading and writing to
-//	individual files.  The operations supported are similar to
-//	the UNIX ones -- type 'man open' to the UNIX prompt.
-//
-//	There are two implementations.  One is a "STUB" that directly
-//	turns the file operations into the underlying UNIX operations.
-//	(cf. comment in filesys.h).
-//
-//	The other is the "real" implementation, that turns these
-//	operations into read and write disk sector requests.
-//	In this baseline implementation of the file system, we don't
-//	worry about concurrent accesses to the file system
-//	by different threads -- this is part of the assignment.
-//
-// Copyright (c) 1992-1993 The Regents of the University of California.
-// All rights reserved.  See copyright.h for copyright notice and limitation
-// of liability and disclaimer of warranty provisions.
-
-#ifndef OPENFILE_H
-#define OPENFILE_H
-
-#include "copyright.h"
-#include "utility.h"
-
-#ifdef FILESYS_STUB // Temporarily implement calls to       \
-					// Nachos file system as calls to UNIX! \
-					// See definitions listed under #else
-class OpenFile
-{
-public:
-	OpenFile(int f)
-	{
-		file = f;
-		currentOffset = 0;
-	}							 // open the file
-	~OpenFile() { Close(file); } // close the file
-
-	int ReadAt(char *into, int numBytes, int position)
-	{
-		Lseek(file, position, 0);
-		return ReadPartial(file, into, numBytes);
-	}
-	int WriteAt(char *from, int numBytes, int position)
-	{
-		Lseek(file, position, 0);
-		WriteFile(file, from, numBytes);
-		return numBytes;
-	}
-	int Read(char *into, int numBytes)
-	{
-		int numRead = ReadAt(into, numBytes, currentOffset);
-		currentOffset += numRead;
-		return numRead;
-	}
-	int Write(char *from, int numBytes)
-	{
-		int numWritten = WriteAt(from, numBytes, currentOffset);
-		currentOffset += numWritten;
-		return numWritten;
-	}
-
-	int Length()
-	{
-		Lseek(file, 0, 2);
-		return Tell(file);
-	}
-
-private:
-	int file;
-	int currentOffset;
-};
-
-#else // FILESYS
-class FileHeader;
-class FileSystem;
-class OpenFile
-{
-public:
-	OpenFile(int sector); // Open a file whose header is located
-						  // at "sector" on the disk
-	OpenFile(FileHeader *hdr)
-	{
-		seekPosition = 0;
-		this->hdr = hdr;
-		filesys = 0;
-	}
-	~OpenFile(); // Close the file
-
-	void Seek(int position); // Set the position from which to
-							 // start reading/writing -- UNIX lseek
-
-	int Read(char *into, int numBytes); // Read/write bytes from the file,
-										// starting at the implicit position.
-										// Return the # actually read/written,
-										// and increment position in file.
-	int Write(char *from, int numBytes);
-
-	int ReadAt(char *into, int numBytes, int position);
-	// Read/write bytes from the file,
-	// bypassing the implicit position.
-	int WriteAt(char *from, int numBytes, int position);
-
-	int Length(); // Return the number of bytes in the
-				  // file (this interface is simpler
-				  // than the UNIX idiom -- lseek to
-				  // end of file, tell, lseek back
-	FileSystem *filesys;
-
-private:
-	FileHeader *hdr;  // Header for this file
-	int seekPosition; // Current position within the file
-	friend class FileSystem;
-};
-
-class PipeFile{
-private :
-	char* buffer;
-	int readPossion;
-	int writePossion;
-	int bufLen;
-public:
-	PipeFile();
-	int write(char* buf, int numBytes);
-	int read(char* buf, int numBytes);
-};
-
-#endif // FILESYS
-
-#endif // OPENFILE_H
+// openfile.h
+//	Data structures for opening, closing, reading and writing to
+//	individual files.  The operations supported are similar to
+//	the UNIX ones -- type 'man open' to the UNIX prompt.
+//
+//	There are two implementations.  One is a "STUB" that directly
+//	turns the file operations into the underlying UNIX operations.
+//	(cf. comment in filesys.h).
+//
+//	The other is the "real" implementation, that turns these
+//	operations into read and write disk sector requests.
+//	In this baseline implementation of the file system, we don't
+//	worry about concurrent accesses to the file system
+//	by different threads -- this is part of the assignment.
+//
+// Copyright (c) 1992-1993 The Regents of the University of California.
+// All rights reserved.  See copyright.h for copyright notice and limitation
+// of liability and disclaimer of warranty provisions.
+
+#ifndef OPENFILE_H
+#define OPENFILE_H
+
+#include "copyright.h"
+#include "utility.h"
+#include "disk.h"
+
+#define MinReadAhead 2	// 检测到顺序访问后的初始预读窗口（扇区数）
+#define MaxReadAhead 16 // 预读窗口的上限
+
+#ifdef FILESYS_STUB // Temporarily implement calls to       \
+					// Nachos file system as calls to UNIX! \
+					// See definitions listed under #else
+class OpenFile
+{
+public:
+	OpenFile(int f)
+	{
+		file = f;
+		currentOffset = 0;
+	}							 // open the file
+	~OpenFile() { Close(file); } // close the file
+
+	int ReadAt(char *into, int numBytes, int position)
+	{
+		Lseek(file, position, 0);
+		return ReadPartial(file, into, numBytes);
+	}
+	int WriteAt(char *from, int numBytes, int position)
+	{
+		Lseek(file, position, 0);
+		WriteFile(file, from, numBytes);
+		return numBytes;
+	}
+	int Read(char *into, int numBytes)
+	{
+		int numRead = ReadAt(into, numBytes, currentOffset);
+		currentOffset += numRead;
+		return numRead;
+	}
+	int Write(char *from, int numBytes)
+	{
+		int numWritten = WriteAt(from, numBytes, currentOffset);
+		currentOffset += numWritten;
+		return numWritten;
+	}
+
+	int Length()
+	{
+		Lseek(file, 0, 2);
+		return Tell(file);
+	}
+
+	void ReadPage(char *into, int position)
+	{
+		int numRead = ReadAt(into, SectorSize, position);
+		if (numRead < 0)
+			numRead = 0;
+		bzero(into + numRead, SectorSize - numRead);
+	}
+	void WritePage(char *from, int position)
+	{
+		int numBytes = Length() - position;
+		if (numBytes > SectorSize)
+			numBytes = SectorSize;
+		if (numBytes > 0)
+			WriteAt(from, numBytes, position);
+	}
+
+private:
+	int file;
+	int currentOffset;
+};
+
+#else // FILESYS
+class FileHeader;
+class FileSystem;
+class OpenFileTable;
+class OpenFile
+{
+public:
+	OpenFile(int sector); // Open a file whose header is located
+						  // at "sector" on the disk
+	OpenFile(FileHeader *hdr)
+	{
+		seekPosition = 0;
+		this->hdr = hdr;
+		hdrSector = -1;
+		filesys = 0;
+		entry = 0;
+		seqPosition = 0;
+		raWindow = 0;
+		raLimit = 0;
+		hdrDirty = FALSE;
+		journaled = FALSE;
+	}
+	~OpenFile(); // Close the file
+
+	void Seek(int position); // Set the position from which to
+							 // start reading/writing -- UNIX lseek
+
+	int Read(char *into, int numBytes); // Read/write bytes from the file,
+										// starting at the implicit position.
+										// Return the # actually read/written,
+										// and increment position in file.
+	int Write(char *from, int numBytes);
+
+	int ReadAt(char *into, int numBytes, int position);
+	// Read/write bytes from the file,
+	// bypassing the implicit position.
+	int WriteAt(char *from, int numBytes, int position);
+
+	int Length(); // Return the number of bytes in the
+				  // file (this interface is simpler
+				  // than the UNIX idiom -- lseek to
+				  // end of file, tell, lseek back
+
+	void ReadPage(char *into, int position);  // 内存映射文件：在position处读/写一个页面
+	void WritePage(char *from, int position); // 直接通过ByteToSector找到扇区，不改变文件长度
+	FileSystem *filesys;
+	OpenFileTable *entry; // 系统打开文件表中的表项，由FileSystem::Open设置
+	bool journaled;	      // 元数据文件（目录、空闲位图），写操作记入日志
+
+private:
+	void readAhead(int position, int numBytes); // 检测顺序访问并预读
+	void zeroGap(int from, int to);             // 清除写到文件末尾之后时跳过的已分配扇区
+	int headerSector();                         // 文件头所在的扇区，-1表示不知道
+
+	FileHeader *hdr;  // Header for this file
+	int hdrSector;	  // 文件头所在的扇区，-1表示不知道
+	int seekPosition; // Current position within the file
+	int seqPosition;  // 顺序访问时下一次读的位置
+	int raWindow;	  // 预读窗口（扇区数），0表示没有检测到顺序访问
+	int raLimit;	  // 已经请求预读到的扇区（文件内的序号，不含）
+	bool hdrDirty;	  // 写过文件，文件头（长度、extent）可能变了
+	friend class FileSystem;
+	friend class Directory;
+};
+
+class PipeFile{
+private :
+	char* buffer;
+	int readPossion;
+	int writePossion;
+	int bufLen;
+public:
+	PipeFile();
+	int write(char* buf, int numBytes);
+	int read(char* buf, int numBytes);
+};
+
+#endif // FILESYS
+
+#endif // OPENFILE_H
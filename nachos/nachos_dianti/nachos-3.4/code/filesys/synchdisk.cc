@@ -1,109 +1,382 @@
-// synchdisk.cc 
-//	Routines to synchronously access the disk.  The physical disk 
-//	is an asynchronous device (disk requests return immediately, and
-//	an interrupt happens later on).  This is a layer on top of
-//	the disk providing a synchronous interface (requests wait until
-//	the request completes).
-//
-//	Use a semaphore to synchronize the interrupt handlers with the
-//	pending requests.  And, because the physical disk can only
-//	handle one operation at a time, use a lock to enforce mutual
-//	exclusion.
-//
-// Copyright (c) 1992-1993 The Regents of the University of California.
-// All rights reserved.  See copyright.h for copyright notice and limitation 
-// of liability and disclaimer of warranty provisions.
-
-#include "copyright.h"
-#include "synchdisk.h"
-
-//----------------------------------------------------------------------
-// DiskRequestDone
-// 	Disk interrupt handler.  Need this to be a C routine, because 
-//	C++ can't handle pointers to member functions.
-//----------------------------------------------------------------------
-
-static void
-DiskRequestDone (int arg)
-{
-    SynchDisk* disk = (SynchDisk *)arg;
-
-    disk->RequestDone();
-}
-
-//----------------------------------------------------------------------
-// SynchDisk::SynchDisk
-// 	Initialize the synchronous interface to the physical disk, in turn
-//	initializing the physical disk.
-//
-//	"name" -- UNIX file name to be used as storage for the disk data
-//	   (usually, "DISK")
-//----------------------------------------------------------------------
-
-SynchDisk::SynchDisk(char* name)
-{
-    semaphore = new Semaphore("synch disk", 0);
-    lock = new Lock("synch disk lock");
-    disk = new Disk(name, DiskRequestDone, (int) this);
-}
-
-//----------------------------------------------------------------------
-// SynchDisk::~SynchDisk
-// 	De-allocate data structures needed for the synchronous disk
-//	abstraction.
-//----------------------------------------------------------------------
-
-SynchDisk::~SynchDisk()
-{
-    delete disk;
-    delete lock;
-    delete semaphore;
-}
-
-//----------------------------------------------------------------------
-// SynchDisk::ReadSector
-// 	Read the contents of a disk sector into a buffer.  Return only
-//	after the data has been read.
-//
-//	"sectorNumber" -- the disk sector to read
-//	"data" -- the buffer to hold the contents of the disk sector
-//----------------------------------------------------------------------
-
-void
-SynchDisk::ReadSector(int sectorNumber, char* data)
-{
-    lock->Acquire();			// only one disk I/O at a time
-    disk->ReadRequest(sectorNumber, data);
-    semaphore->P();			// wait for interrupt
-    lock->Release();
-}
-
-//----------------------------------------------------------------------
-// SynchDisk::WriteSector
-// 	Write the contents of a buffer into a disk sector.  Return only
-//	after the data has been written.
-//
-//	"sectorNumber" -- the disk sector to be written
-//	"data" -- the new contents of the disk sector
-//----------------------------------------------------------------------
-
-void
-SynchDisk::WriteSector(int sectorNumber, char* data)
-{
-    lock->Acquire();			// only one disk I/O at a time
-    disk->WriteRequest(sectorNumber, data);
-    semaphore->P();			// wait for interrupt
-    lock->Release();
-}
-
-//----------------------------------------------------------------------
-// SynchDisk::RequestDone
-// 	Disk interrupt handler.  Wake up any thread waiting for the disk
-//	request to finish.
-//----------------------------------------------------------------------
-
-void
-SynchDisk::RequestDone()
-{ 
-    semaphore->V();
-}
+// synchdisk.cc 
+//	Routines to synchronously access the disk.  The physical disk 
+//	is an asynchronous device (disk requests return immediately, and
+//	an interrupt happens later on).  This is a layer on top of
+//	the disk providing a synchronous interface (requests wait until
+//	the request completes).
+//
+//	Use a semaphore per request to synchronize the interrupt handler
+//	with the thread waiting for it.  Because the physical disk can
+//	only handle one operation at a time, requests are kept in a queue;
+//	when the disk finishes one, the interrupt handler picks the next
+//	according to the scheduling policy (FIFO, SSTF, SCAN, C-LOOK or
+//	DEADLINE) and starts it, merging in any queued requests for the
+//	neighbouring sectors.
+//
+// Copyright (c) 1992-1993 The Regents of the University of California.
+// All rights reserved.  See copyright.h for copyright notice and limitation 
+// of liability and disclaimer of warranty provisions.
+
+#include "copyright.h"
+#include "synchdisk.h"
+#include "system.h"
+
+//----------------------------------------------------------------------
+// DiskRequestDone
+// 	Disk interrupt handler.  Need this to be a C routine, because 
+//	C++ can't handle pointers to member functions.
+//----------------------------------------------------------------------
+
+static void
+DiskRequestDone (int arg)
+{
+    SynchDisk* disk = (SynchDisk *)arg;
+
+    disk->RequestDone();
+}
+
+//----------------------------------------------------------------------
+// SynchDisk::SynchDisk
+// 	Initialize the synchronous interface to the physical disk, in turn
+//	initializing the physical disk.
+//
+//	"name" -- UNIX file name to be used as storage for the disk data
+//	   (usually, "DISK")
+//	"order" -- how to order requests from different threads
+//	"mapped" -- have the Disk mmap its UNIX file
+//----------------------------------------------------------------------
+
+SynchDisk::SynchDisk(char* name, DiskSchedPolicy order, bool mapped)
+{
+    policy = order;
+    queue = new List;
+    current = NULL;
+    transferBuf = new char[MaxDiskTransfer * SectorSize];
+    headSector = 0;
+    sweepUp = TRUE;
+    disk = new Disk(name, DiskRequestDone, (int) this, mapped);
+}
+
+//----------------------------------------------------------------------
+// SynchDisk::~SynchDisk
+// 	De-allocate data structures needed for the synchronous disk
+//	abstraction.
+//----------------------------------------------------------------------
+
+SynchDisk::~SynchDisk()
+{
+    delete disk;
+    delete queue;
+    delete [] transferBuf;
+}
+
+//----------------------------------------------------------------------
+// WakeRequester
+// 	Completion callback used by the synchronous interface: wake up the
+//	thread waiting on the semaphore passed as the argument.
+//----------------------------------------------------------------------
+
+static void
+WakeRequester(int arg)
+{
+    ((Semaphore *) arg)->V();
+}
+
+//----------------------------------------------------------------------
+// SynchDisk::ReadSector
+// 	Read the contents of a disk sector into a buffer.  Return only
+//	after the data has been read.
+//
+//	"sectorNumber" -- the disk sector to read
+//	"data" -- the buffer to hold the contents of the disk sector
+//----------------------------------------------------------------------
+
+void
+SynchDisk::ReadSector(int sectorNumber, char* data)
+{
+    Semaphore *done = new Semaphore("disk request", 0);
+
+    SubmitRead(sectorNumber, data, WakeRequester, (int) done);
+    done->P();				// wait for interrupt
+    delete done;
+}
+
+//----------------------------------------------------------------------
+// SynchDisk::WriteSector
+// 	Write the contents of a buffer into a disk sector.  Return only
+//	after the data has been written.
+//
+//	"sectorNumber" -- the disk sector to be written
+//	"data" -- the new contents of the disk sector
+//----------------------------------------------------------------------
+
+void
+SynchDisk::WriteSector(int sectorNumber, char* data)
+{
+    Semaphore *done = new Semaphore("disk request", 0);
+
+    SubmitWrite(sectorNumber, data, WakeRequester, (int) done);
+    done->P();				// wait for interrupt
+    delete done;
+}
+
+//----------------------------------------------------------------------
+// SynchDisk::ReadSectors/WriteSectors
+// 	Read/write "numSectors" consecutive sectors, starting at
+//	sectorNumber, to/from a contiguous buffer, as a single disk request.
+//	Return only once the transfer is done.
+//----------------------------------------------------------------------
+
+void
+SynchDisk::ReadSectors(int sectorNumber, int numSectors, char* data)
+{
+    Semaphore *done = new Semaphore("disk request", 0);
+
+    SubmitRead(sectorNumber, data, WakeRequester, (int) done, numSectors);
+    done->P();
+    delete done;
+}
+
+void
+SynchDisk::WriteSectors(int sectorNumber, int numSectors, char* data)
+{
+    Semaphore *done = new Semaphore("disk request", 0);
+
+    SubmitWrite(sectorNumber, data, WakeRequester, (int) done, numSectors);
+    done->P();
+    delete done;
+}
+
+//----------------------------------------------------------------------
+// SynchDisk::SubmitRead/SubmitWrite
+// 	Queue a request without waiting for it.  The buffer must stay
+//	valid until the callback has been called.
+//----------------------------------------------------------------------
+
+void
+SynchDisk::SubmitRead(int sectorNumber, char* data,
+                      VoidFunctionPtr callback, int callbackArg, int numSectors)
+{
+    submit(sectorNumber, numSectors, data, FALSE, callback, callbackArg);
+}
+
+void
+SynchDisk::SubmitWrite(int sectorNumber, char* data,
+                       VoidFunctionPtr callback, int callbackArg, int numSectors)
+{
+    submit(sectorNumber, numSectors, data, TRUE, callback, callbackArg);
+}
+
+//----------------------------------------------------------------------
+// SynchDisk::RequestDone
+// 	Disk interrupt handler.  Tell whoever submitted the requests in the
+//	transfer that they are finished, and start the next queued request.
+//	For a merged read the data is still in transferBuf and is copied
+//	out to each request's buffer first.
+//----------------------------------------------------------------------
+
+void
+SynchDisk::RequestDone()
+{ 
+    DiskRequest *request = current;
+    bool merged = (request != NULL && request->next != NULL);
+    int oldest = stats->totalTicks;
+
+    ASSERT(request != NULL);
+    current = NULL;
+    while (request != NULL) {
+        DiskRequest *next = request->next;
+        if (merged && !request->writing)
+            bcopy(transferBuf + (request->sector - currentSector) * SectorSize,
+                  request->data, request->count * SectorSize);
+        if (request->arrival < oldest)
+            oldest = request->arrival;
+        (*request->callback)(request->callbackArg);
+        delete request;
+        request = next;
+    }
+    stats->diskWaitTicks += stats->totalTicks - oldest;
+    dispatch();
+}
+
+char *
+SynchDisk::PolicyName()
+{
+    static char *names[] = { "FIFO", "SSTF", "SCAN", "C-LOOK", "DEADLINE" };
+    return names[policy];
+}
+
+//----------------------------------------------------------------------
+// SynchDisk::submit
+// 	Add a request to the queue, and hand it to the disk right away if
+//	the disk is idle.  The queue is also used by the interrupt handler,
+//	so interrupts are disabled while it is touched.
+//----------------------------------------------------------------------
+
+void
+SynchDisk::submit(int sector, int count, char *data, bool writing,
+                  VoidFunctionPtr callback, int callbackArg)
+{
+    DiskRequest *request = new DiskRequest;
+    IntStatus oldLevel = interrupt->SetLevel(IntOff);
+
+    ASSERT(count > 0 && count <= MaxDiskTransfer);
+    request->sector = sector;
+    request->count = count;
+    request->next = NULL;
+    request->data = data;
+    request->writing = writing;
+    request->callback = callback;
+    request->callbackArg = callbackArg;
+    request->arrival = stats->totalTicks;
+    queue->Append((void *) request);
+    if (current == NULL)
+        dispatch();
+    (void) interrupt->SetLevel(oldLevel);
+}
+
+//----------------------------------------------------------------------
+// SynchDisk::dispatch
+// 	Start the request chosen by the scheduling policy, if any.
+//	Called with interrupts disabled.
+//----------------------------------------------------------------------
+
+void
+SynchDisk::dispatch()
+{
+    if (current != NULL)		// a callback may already have
+        return;				// started a new request
+    DiskRequest *request = selectNext();
+
+    if (request == NULL)
+        return;
+    queue->Remove((void *) request);
+    merge(request);
+    stats->diskSeekTracks += abs(currentSector / SectorsPerTrack
+                                 - headSector / SectorsPerTrack);
+    headSector = currentSector + currentCount - 1;
+    DEBUG('d', "Dispatching %s of %d sectors at %d (%s)\n",
+          request->writing ? "write" : "read", currentCount, currentSector,
+          PolicyName());
+
+    char *data = current->data;
+    if (current->next != NULL) {	// 合并过的请求经过transferBuf
+        data = transferBuf;
+        if (request->writing)
+            for (DiskRequest *r = current; r != NULL; r = r->next)
+                bcopy(r->data, transferBuf + (r->sector - currentSector) * SectorSize,
+                      r->count * SectorSize);
+    }
+    if (request->writing)
+        disk->WriteRequest(currentSector, data, currentCount);
+    else
+        disk->ReadRequest(currentSector, data, currentCount);
+}
+
+//----------------------------------------------------------------------
+// SynchDisk::merge
+// 	Make "request" the current transfer, and grow it with any queued
+//	requests in the same direction that start right after it or end
+//	right before it, as long as the whole transfer fits in
+//	MaxDiskTransfer sectors.  The merged requests are kept in current
+//	in sector order.
+//----------------------------------------------------------------------
+
+void
+SynchDisk::merge(DiskRequest *request)
+{
+    DiskRequest *tail = request;
+    bool grew = TRUE;
+
+    current = request;
+    currentSector = request->sector;
+    currentCount = request->count;
+    while (grew) {
+        grew = FALSE;
+        for (ListElement *e = queue->getHead(); e != NULL; e = e->next) {
+            DiskRequest *r = (DiskRequest *) e->item;
+            if (r->writing != request->writing
+                    || currentCount + r->count > MaxDiskTransfer)
+                continue;
+            if (r->sector == currentSector + currentCount) {
+                tail->next = r;		// 接在后面
+                tail = r;
+            } else if (r->sector + r->count == currentSector) {
+                r->next = current;	// 接在前面
+                current = r;
+                currentSector = r->sector;
+            } else
+                continue;
+            currentCount += r->count;
+            queue->Remove((void *) r);
+            grew = TRUE;
+            break;
+        }
+    }
+}
+
+//----------------------------------------------------------------------
+// SynchDisk::selectNext
+// 	Choose which queued request the disk should serve next.  Distances
+//	are measured in sectors, which orders requests by track first and
+//	then by position within the track (cf. disk.h).
+//----------------------------------------------------------------------
+
+DiskRequest *
+SynchDisk::selectNext()
+{
+    ListElement *e;
+    DiskRequest *best = NULL;
+
+    if (queue->IsEmpty())
+        return NULL;
+    DiskRequest *oldest = (DiskRequest *) queue->getHead()->item;
+
+    switch (policy) {
+      case DiskFIFO:
+        return oldest;
+
+      case DiskSSTF:
+        for (e = queue->getHead(); e != NULL; e = e->next) {
+            DiskRequest *r = (DiskRequest *) e->item;
+            if (best == NULL || abs(r->sector - headSector)
+                                < abs(best->sector - headSector))
+                best = r;
+        }
+        return best;
+
+      case DiskSCAN:
+        for (int pass = 0; pass < 2 && best == NULL; pass++) {
+            for (e = queue->getHead(); e != NULL; e = e->next) {
+                DiskRequest *r = (DiskRequest *) e->item;
+                if (sweepUp ? r->sector < headSector : r->sector > headSector)
+                    continue;
+                if (best == NULL || abs(r->sector - headSector)
+                                    < abs(best->sector - headSector))
+                    best = r;
+            }
+            if (best == NULL)
+                sweepUp = !sweepUp;	// 这个方向上没有请求了，掉头
+        }
+        return best;
+
+      case DiskDeadline:
+        if (stats->totalTicks - oldest->arrival > DiskDeadlineTicks)
+            return oldest;		// 等待太久的请求优先
+        // fall through
+
+      case DiskCLOOK: {
+        DiskRequest *lowest = NULL;
+        for (e = queue->getHead(); e != NULL; e = e->next) {
+            DiskRequest *r = (DiskRequest *) e->item;
+            if (r->sector >= headSector
+                    && (best == NULL || r->sector < best->sector))
+                best = r;
+            if (lowest == NULL || r->sector < lowest->sector)
+                lowest = r;
+        }
+        return (best != NULL) ? best : lowest;	// 到头后回到最低的请求
+      }
+    }
+    return oldest;
+}
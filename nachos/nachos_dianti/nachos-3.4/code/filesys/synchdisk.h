@@ -1,53 +1,127 @@
-// synchdisk.h 
-// 	Data structures to export a synchronous interface to the raw 
-//	disk device.
-//
-// Copyright (c) 1992-1993 The Regents of the University of California.
-// All rights reserved.  See copyright.h for copyright notice and limitation 
-// of liability and disclaimer of warranty provisions.
-
-#include "copyright.h"
-
-#ifndef SYNCHDISK_H
-#define SYNCHDISK_H
-
-#include "disk.h"
-#include "synch.h"
-
-// The following class defines a "synchronous" disk abstraction.
-// As with other I/O devices, the raw physical disk is an asynchronous device --
-// requests to read or write portions of the disk return immediately,
-// and an interrupt occurs later to signal that the operation completed.
-// (Also, the physical characteristics of the disk device assume that
-// only one operation can be requested at a time).
-//
-// This class provides the abstraction that for any individual thread
-// making a request, it waits around until the operation finishes before
-// returning.
-class SynchDisk {
-  public:
-    SynchDisk(char* name);    		// Initialize a synchronous disk,
-					// by initializing the raw Disk.
-    ~SynchDisk();			// De-allocate the synch disk data
-    
-    void ReadSector(int sectorNumber, char* data);
-    					// Read/write a disk sector, returning
-    					// only once the data is actually read 
-					// or written.  These call
-    					// Disk::ReadRequest/WriteRequest and
-					// then wait until the request is done.
-    void WriteSector(int sectorNumber, char* data);
-    
-    void RequestDone();			// Called by the disk device interrupt
-					// handler, to signal that the
-					// current disk operation is complete.
-
-  private:
-    Disk *disk;		  		// Raw disk device
-    Semaphore *semaphore; 		// To synchronize requesting thread 
-					// with the interrupt handler
-    Lock *lock;		  		// Only one read/write request
-					// can be sent to the disk at a time
-};
-
-#endif // SYNCHDISK_H
+// synchdisk.h 
+// 	Data structures to export a synchronous interface to the raw 
+//	disk device.
+//
+// Copyright (c) 1992-1993 The Regents of the University of California.
+// All rights reserved.  See copyright.h for copyright notice and limitation 
+// of liability and disclaimer of warranty provisions.
+
+#include "copyright.h"
+
+#ifndef SYNCHDISK_H
+#define SYNCHDISK_H
+
+#include "disk.h"
+#include "synch.h"
+#include "list.h"
+
+// Disk scheduling policies, selected with -ds
+enum DiskSchedPolicy {
+    DiskFIFO,		// in order of arrival
+    DiskSSTF,		// shortest seek first
+    DiskSCAN,		// elevator: sweep up and down across the tracks
+    DiskCLOOK,		// sweep upward only, then jump back to the lowest request
+    DiskDeadline	// C-LOOK, but a request older than DiskDeadlineTicks
+			// is served next no matter where it is
+};
+
+#define DiskDeadlineTicks 50000	// DiskDeadline的最长等待时间
+#define MaxDiskTransfer SectorsPerTrack	// 合并后一次磁盘请求的最多扇区数
+
+// One queued disk request.
+class DiskRequest {
+  public:
+    int sector;			// first sector to read or write
+    int count;			// number of consecutive sectors
+    char *data;			// buffer holding / receiving the sectors
+    bool writing;		// write request?
+    int arrival;		// totalTicks when the request was queued
+    VoidFunctionPtr callback;	// called (from the disk interrupt handler)
+    int callbackArg;		// when the request completes
+    DiskRequest *next;		// next request merged into the same transfer
+};
+
+// The following class defines a "synchronous" disk abstraction.
+// As with other I/O devices, the raw physical disk is an asynchronous device --
+// requests to read or write portions of the disk return immediately,
+// and an interrupt occurs later to signal that the operation completed.
+// (Also, the physical characteristics of the disk device assume that
+// only one operation can be requested at a time).
+//
+// This class provides the abstraction that for any individual thread
+// making a request, it waits around until the operation finishes before
+// returning.  Requests from different threads are kept in a queue; each
+// time the disk finishes a request, the scheduling policy picks which
+// queued request is sent to the disk next.
+//
+// SubmitRead/SubmitWrite are the asynchronous interface underneath:
+// they queue a request and return at once, and the callback is invoked
+// when the request completes.  The callback runs inside the disk
+// interrupt handler, with interrupts disabled, so it must not block;
+// typically it V's a semaphore or marks a buffer ready.  A caller may
+// keep any number of requests in flight.
+//
+// When a request is sent to the disk, any queued requests in the same
+// direction for the sectors just before or after it are merged into one
+// multi-sector transfer (up to MaxDiskTransfer sectors), so a burst of
+// requests for consecutive sectors costs one seek instead of one each.
+class SynchDisk {
+  public:
+    SynchDisk(char* name, DiskSchedPolicy order = DiskFIFO,
+              bool mapped = FALSE);
+    					// Initialize a synchronous disk,
+					// by initializing the raw Disk.
+    ~SynchDisk();			// De-allocate the synch disk data
+    
+    void ReadSector(int sectorNumber, char* data);
+    					// Read/write a disk sector, returning
+    					// only once the data is actually read 
+					// or written.  These queue a request
+    					// for Disk::ReadRequest/WriteRequest and
+					// then wait until the request is done.
+    void WriteSector(int sectorNumber, char* data);
+
+    void ReadSectors(int sectorNumber, int numSectors, char* data);
+    void WriteSectors(int sectorNumber, int numSectors, char* data);
+					// Same, for numSectors consecutive
+					// sectors in one disk request
+
+    void SubmitRead(int sectorNumber, char* data,
+		    VoidFunctionPtr callback, int callbackArg,
+		    int numSectors = 1);
+    void SubmitWrite(int sectorNumber, char* data,
+		     VoidFunctionPtr callback, int callbackArg,
+		     int numSectors = 1);
+					// Queue a read/write and return
+					// immediately; (*callback)(callbackArg)
+					// is called when it completes
+    
+    void RequestDone();			// Called by the disk device interrupt
+					// handler, to signal that the
+					// current disk operation is complete.
+
+    char *PolicyName();			// name of the scheduling policy
+
+  private:
+    void submit(int sector, int count, char *data, bool writing,
+		VoidFunctionPtr callback, int callbackArg);
+					// queue a request, start it if idle
+    void dispatch();			// send the next request to the disk
+    DiskRequest *selectNext();		// apply the scheduling policy
+    void merge(DiskRequest *request);	// pull adjacent requests out of
+					// the queue into current
+
+    Disk *disk;		  		// Raw disk device
+    DiskSchedPolicy policy;
+    List *queue;			// requests waiting for the disk
+    DiskRequest *current;		// requests the disk is working on,
+					// linked by next in sector order
+    int currentSector;			// first sector of the transfer
+    int currentCount;			// its length in sectors
+    char *transferBuf;			// staging area for merged transfers
+    int headSector;			// sector of the last request sent to
+					// the disk, i.e. where the head is
+    bool sweepUp;			// SCAN: current direction of the sweep
+};
+
+#endif // SYNCHDISK_H
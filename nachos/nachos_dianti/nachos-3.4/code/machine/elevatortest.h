@@ -1,15 +1,15 @@
-// elevatortest.h 
-//	 Defines self test module for elevator device.
-//
-// Copyright (c) 1996 The Regents of the University of California.
-// All rights reserved.  See copyright.h for copyright notice and limitation 
-// of liability and disclaimer of warranty provisions.
-
-#ifndef ELEVATORTEST_H
-#define ELEVATORTEST_H
-
-#include "copyright.h"
-
-extern void ElevatorSelfTest();
-
+// elevatortest.h 
+//	 Defines self test module for elevator device.
+//
+// Copyright (c) 1996 The Regents of the University of California.
+// All rights reserved.  See copyright.h for copyright notice and limitation 
+// of liability and disclaimer of warranty provisions.
+
+#ifndef ELEVATORTEST_H
+#define ELEVATORTEST_H
+
+#include "copyright.h"
+
+extern void ElevatorSelfTest();
+
 #endif ELEVATORTEST_H
\ No newline at end of file
@@ -1,34 +1,34 @@
-/* sort.c 
- *    Test program to sort a large number of integers.
- *
- *    Intention is to stress virtual memory system.
- *
- *    Ideally, we could read the unsorted array off of the file system,
- *	and store the result back to the file system!
- */
-
-#include "syscall.h"
-int size = 20;
-int A[20];	/* size of physical memory; with code, we'll run out of space!*/
-
-int
-main()
-{
-    int i, j, tmp;
-
-    /* first initialize the array, in reverse sorted order */
-    for (i = 0; i < size; i++)
-        A[i] = 1024 - i;
-
-    /* then sort! */
-    for(i = 0; i < size - 1; i ++){
-    	for(j = size - 1; j > i; j --){
-    		if(A[j] > A[j-1]){
-    			tmp = A[j];
-    			A[j] = A[j-1];
-    			A[j-1] = tmp;
-    		}
-    	}
-    }
-    Exit(A[0]);		/* and then we're done -- should be 1024! */
-}
+/* sort.c 
+ *    Test program to sort a large number of integers.
+ *
+ *    Intention is to stress virtual memory system.
+ *
+ *    Ideally, we could read the unsorted array off of the file system,
+ *	and store the result back to the file system!
+ */
+
+#include "syscall.h"
+int size = 20;
+int A[20];	/* size of physical memory; with code, we'll run out of space!*/
+
+int
+main()
+{
+    int i, j, tmp;
+
+    /* first initialize the array, in reverse sorted order */
+    for (i = 0; i < size; i++)
+        A[i] = 1024 - i;
+
+    /* then sort! */
+    for(i = 0; i < size - 1; i ++){
+    	for(j = size - 1; j > i; j --){
+    		if(A[j] > A[j-1]){
+    			tmp = A[j];
+    			A[j] = A[j-1];
+    			A[j-1] = tmp;
+    		}
+    	}
+    }
+    Exit(A[0]);		/* and then we're done -- should be 1024! */
+}
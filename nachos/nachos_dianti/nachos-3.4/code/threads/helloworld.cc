@@ -1,6 +1,6 @@
-#include "copyright.h"
-#include <stdio.h>
-
-void printHello(){
-    printf("Hello world\n");
+#include "copyright.h"
+#include <stdio.h>
+
+void printHello(){
+    printf("Hello world\n");
 }
\ No newline at end of file
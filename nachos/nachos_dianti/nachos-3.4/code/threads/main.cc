@@ -9,9 +9,11 @@
 // 	Most of this file is not needed until later assignments.
 //
 // Usage: nachos -d <debugflags> -rs <random seed #>
-//		-s -x <nachos file> -c <consoleIn> <consoleOut>
-//		-f -cp <unix file> <nachos file>
-//		-p <nachos file> -r <nachos file> -l -D -t
+//		-s -lp -x <nachos file> -c <consoleIn> <consoleOut>
+//		-f -tracks <disk tracks> -bc <cache sectors> -ds <disk policy> -dm
+//		-cp <unix file> <nachos file>
+//		-import <unix path> <nachos path> -export <nachos dir> <unix dir>
+//		-lf -dt -p <nachos file> -r <nachos file> -l -D -t
 //              -n <network reliability> -m <machine id>
 //              -o <other machine id>
 //              -z
@@ -22,12 +24,22 @@
 //
 //  USER_PROGRAM
 //    -s causes user programs to be executed in single-step mode
+//    -lp maps contiguous code/data segments with large pages
 //    -x runs a user program
 //    -c tests the console
 //
 //  FILESYS
 //    -f causes the physical disk to be formatted
+//    -tracks sets the size of a newly formatted disk, in tracks of 32 sectors
+//    -bc sets the number of sectors in the buffer cache
+//    -ds sets the disk scheduling policy: fifo, sstf, scan, clook, deadline
+//    -dm maps the DISK file into memory instead of using read/write on it
 //    -cp copies a file from UNIX to Nachos
+//    -import copies a UNIX file or directory tree into Nachos, then halts
+//    -export copies a Nachos directory tree out to UNIX, then halts
+//    -lf runs the large/sparse file stress test, then halts
+//    -dt reports seek distance and latency of the -ds policy under
+//		concurrent readers, then halts
 //    -p prints a Nachos file to stdout
 //    -r removes a Nachos file from the file system
 //    -l lists the contents of the Nachos directory
@@ -67,6 +79,8 @@ extern void printHello();
 extern void testProg();
 extern void testFileSystem();
 extern void testShell();
+extern void Import(char *from, char *to), Export(char *from, char *to);
+extern void LargeFileTest(), DiskSchedTest();
 //----------------------------------------------------------------------
 // main
 // 	Bootstrap the operating system kernel.
@@ -89,6 +103,32 @@ int main(int argc, char **argv) {
 	DEBUG('t', "Entering main");
 	(void) Initialize(argc, argv);
 
+#ifdef FILESYS
+	bool staged = FALSE;
+	for (argc--, argv++; argc > 0; argc -= argCount, argv += argCount) {
+		argCount = 1;
+		if (!strcmp(*argv, "-import")) {	// 装载测试程序等，不运行测试
+			ASSERT(argc > 2);
+			Import(*(argv + 1), *(argv + 2));
+			staged = TRUE;
+			argCount = 3;
+		} else if (!strcmp(*argv, "-export")) {
+			ASSERT(argc > 2);
+			Export(*(argv + 1), *(argv + 2));
+			staged = TRUE;
+			argCount = 3;
+		} else if (!strcmp(*argv, "-lf")) {
+			LargeFileTest();
+			staged = TRUE;
+		} else if (!strcmp(*argv, "-dt")) {	// 每种策略运行一次：-ds <policy> -dt
+			DiskSchedTest();
+			staged = TRUE;
+		}
+	}
+	if (staged)
+		interrupt->Halt();
+#endif
+
 //#ifdef THREADS
 //	ThreadTest();
 //#endif
@@ -1,232 +1,473 @@
-// addrspace.cc
-//	Routines to manage address spaces (executing user programs).
-//
-//	In order to run a user program, you must:
-//
-//	1. link with the -N -T 0 option
-//	2. run coff2noff to convert the object file to Nachos format
-//		(Nachos object code format is essentially just a simpler
-//		version of the UNIX executable object code format)
-//	3. load the NOFF file into the Nachos file system
-//		(if you haven't implemented the file system yet, you
-//		don't need to do this last step)
-//
-// Copyright (c) 1992-1993 The Regents of the University of California.
-// All rights reserved.  See copyright.h for copyright notice and limitation
-// of liability and disclaimer of warranty provisions.
-
-#include "copyright.h"
-#include "system.h"
-#include "addrspace.h"
-#include "noff.h"
-#ifdef HOST_SPARC
-#include <strings.h>
-#endif
-
-//----------------------------------------------------------------------
-// SwapHeader
-// 	Do little endian to big endian conversion on the bytes in the
-//	object file header, in case the file was generated on a little
-//	endian machine, and we're now running on a big endian machine.
-//----------------------------------------------------------------------
-
-static void SwapHeader(NoffHeader *noffH) {
-	noffH->noffMagic = WordToHost(noffH->noffMagic);
-	noffH->code.size = WordToHost(noffH->code.size);
-	noffH->code.virtualAddr = WordToHost(noffH->code.virtualAddr);
-	noffH->code.inFileAddr = WordToHost(noffH->code.inFileAddr);
-	noffH->initData.size = WordToHost(noffH->initData.size);
-	noffH->initData.virtualAddr = WordToHost(noffH->initData.virtualAddr);
-	noffH->initData.inFileAddr = WordToHost(noffH->initData.inFileAddr);
-	noffH->uninitData.size = WordToHost(noffH->uninitData.size);
-	noffH->uninitData.virtualAddr = WordToHost(noffH->uninitData.virtualAddr);
-	noffH->uninitData.inFileAddr = WordToHost(noffH->uninitData.inFileAddr);
-}
-AddrSpace::AddrSpace(Thread* toCopy) {
-	numPages = toCopy->space->numPages;
-	pageTable = new TranslationEntry[numPages];
-	for (int i = 0; i < numPages; i++) {
-		if (toCopy->space->pageTable[i].codeData == TRUE) {
-			memcpy(&pageTable[i], &(toCopy->space->pageTable[i]),
-					sizeof(TranslationEntry));
-		}
-		pageTable[i].virtualPage = i;
-	}
-}
-//----------------------------------------------------------------------
-// AddrSpace::AddrSpace
-// 	Create an address space to run a user program.
-//	Load the program from a file "executable", and set everything
-//	up so that we can start executing user instructions.
-//
-//	Assumes that the object code file is in NOFF format.
-//
-//	First, set up the translation from program memory to physical
-//	memory.  For now, this is really simple (1:1), since we are
-//	only uniprogramming, and we have a single unsegmented page table
-//
-//	"executable" is the file containing the object code to load into memory
-//----------------------------------------------------------------------
-
-AddrSpace::AddrSpace(OpenFile *executable) {
-	NoffHeader noffH;
-	unsigned int i, size;
-
-	executable->ReadAt((char *) &noffH, sizeof(noffH), 0);
-	if ((noffH.noffMagic != NOFFMAGIC)
-			&& (WordToHost(noffH.noffMagic) == NOFFMAGIC))
-		SwapHeader(&noffH);
-	ASSERT(noffH.noffMagic == NOFFMAGIC);
-
-	// how big is address space?
-	size = noffH.code.size + noffH.initData.size + noffH.uninitData.size
-			+ UserStackSize; // we need to increase the size
-							 // to leave room for the stack
-	numPages = divRoundUp(size, PageSize);
-	size = numPages * PageSize;
-
-	ASSERT(numPages <= NumPhysPages); // check we're not trying
-									  // to run anything too big --
-									  // at least until we have
-									  // virtual memory
-
-	DEBUG('a', "Initializing address space, num pages %d, size %d\n", numPages,
-			size);
-	// first, set up the translation
-	pageTable = new TranslationEntry[numPages];
-	for (i = 0; i < numPages; i++) {
-		pageTable[i].virtualPage = i;
-		pageTable[i].valid = FALSE;
-		pageTable[i].use = FALSE;
-		pageTable[i].dirty = FALSE;
-		pageTable[i].readOnly = FALSE;
-		pageTable[i].onDisk = FALSE;           // 不在磁盘上有缓存
-		pageTable[i].codeData = FALSE;
-	}
-
-	// 不清零主存
-	// zero out the entire address space, to zero the unitialized data segment
-	// and the stack segment
-	//   bzero(machine->mainMemory, size);
-
-	if (noffH.code.size > 0) {
-		DEBUG('a', "Initializing code segment, at 0x%x, size %d\n",
-				noffH.code.virtualAddr, noffH.code.size);
-		/* 将其加载至虚拟磁盘 */
-		unsigned codeVirAddr = (unsigned) noffH.code.virtualAddr;
-		unsigned int offset = codeVirAddr % PageSize;  //偏移
-		unsigned int vpn = codeVirAddr / PageSize;  //第一个虚拟页号
-		int codePages = divRoundUp(noffH.code.size + offset, PageSize); //总计需要的页面数量
-		int totalCodeSize = codePages * PageSize;    // 总计的代码所需页面大小
-		char* allDisk = new char[totalCodeSize];    //分配一个大块磁盘
-		bzero(allDisk, totalCodeSize);
-		executable->ReadAt(allDisk + offset, noffH.code.size,
-				noffH.code.inFileAddr);   //读取所有代码到磁盘上
-		for (int i = 0; i < codePages; i++) {     //将磁盘分割为小块映射到内存页
-
-			char* diskPage = allDisk + PageSize * i;
-			pageTable[vpn + i].onDisk = true;
-			pageTable[vpn + i].diskAddr = diskPage;
-			pageTable[vpn + i].codeData = TRUE;
-			machine->disk->Append((void*) diskPage);  //加入虚拟磁
-		}
-	}
-	if (noffH.initData.size > 0) {
-		DEBUG('a', "Initializing data segment, at 0x%x, size %d\n",
-				noffH.initData.virtualAddr, noffH.initData.size);
-		/* 将其加载至虚拟磁盘 */
-		unsigned dataVirAddr = (unsigned) noffH.initData.virtualAddr;
-		unsigned int offset = dataVirAddr % PageSize;  //偏移
-		unsigned int vpn = dataVirAddr / PageSize;  //第一个虚拟页号
-		int dataPages = divRoundUp(noffH.initData.size + offset, PageSize); //总计需要的页面数量
-		int totalDataSize = dataPages * PageSize;
-		char* allDisk = new char[totalDataSize];    //分配一个大块磁盘
-		bzero(allDisk, totalDataSize);
-		executable->ReadAt(allDisk + offset, noffH.initData.size,
-				noffH.initData.inFileAddr);   //读取所有数据到磁盘上
-		for (int i = 0; i < dataPages; i++) {   //  分割磁盘块
-			char* diskPage = allDisk + PageSize * i;
-			if (pageTable[vpn + i].onDisk == FALSE) {
-				pageTable[vpn + i].onDisk = true;
-				pageTable[vpn + i].diskAddr = diskPage;
-				pageTable[vpn + i].codeData = TRUE;
-				machine->disk->Append((void*) diskPage);  //加入虚拟磁盘
-			} else {    //拷贝到原来已经分配好的磁盘块
-				for (int j = 0; j < PageSize; j++) {
-					if (diskPage[j] != 0) {
-						((char*) (pageTable[vpn + i].diskAddr))[j] =
-								diskPage[j];
-					}
-				}
-			}
-
-		}
-	}
-}
-
-//----------------------------------------------------------------------
-// AddrSpace::~AddrSpace
-// 	Dealloate an address space.  Nothing for now!
-//----------------------------------------------------------------------
-
-AddrSpace::~AddrSpace() {
-	delete pageTable;
-}
-
-//----------------------------------------------------------------------
-// AddrSpace::InitRegisters
-// 	Set the initial values for the user-level register set.
-//
-// 	We write these directly into the "machine" registers, so
-//	that we can immediately jump to user code.  Note that these
-//	will be saved/restored into the currentThread->userRegisters
-//	when this thread is context switched out.
-//----------------------------------------------------------------------
-
-void AddrSpace::InitRegisters() {
-	int i;
-
-	for (i = 0; i < NumTotalRegs; i++)
-		machine->WriteRegister(i, 0);
-
-	// Initial program counter -- must be location of "Start"
-	machine->WriteRegister(PCReg, 0);
-
-	// Need to also tell MIPS where next instruction is, because
-	// of branch delay possibility
-	machine->WriteRegister(NextPCReg, 4);
-
-	// Set the stack register to the end of the address space, where we
-	// allocated the stack; but subtract off a bit, to make sure we don't
-	// accidentally reference off the end!
-	machine->WriteRegister(StackReg, numPages * PageSize - 16);
-	DEBUG('a', "Initializing stack register to %d\n", numPages * PageSize - 16);
-}
-
-void AddrSpace::setPC(int func) {
-	machine->WriteRegister(PCReg, func);
-	machine->WriteRegister(NextPCReg, func + 4);
-}
-//----------------------------------------------------------------------
-// AddrSpace::SaveState
-// 	On a context switch, save any machine state, specific
-//	to this address space, that needs saving.
-//
-//	For now, nothing!
-//----------------------------------------------------------------------
-
-void AddrSpace::SaveState() {
-}
-
-//----------------------------------------------------------------------
-// AddrSpace::RestoreState
-// 	On a context switch, restore the machine state so that
-//	this address space can run.
-//
-//      For now, tell the machine where to find the page table.
-//----------------------------------------------------------------------
-
-void AddrSpace::RestoreState() {
-	machine->pageTable = pageTable;
-	machine->pageTableSize = numPages;
-}
+// addrspace.cc
+//	Routines to manage address spaces (executing user programs).
+//
+//	In order to run a user program, you must:
+//
+//	1. link with the -N -T 0 option
+//	2. run coff2noff to convert the object file to Nachos format
+//		(Nachos object code format is essentially just a simpler
+//		version of the UNIX executable object code format)
+//	3. load the NOFF file into the Nachos file system
+//		(if you haven't implemented the file system yet, you
+//		don't need to do this last step)
+//
+// Copyright (c) 1992-1993 The Regents of the University of California.
+// All rights reserved.  See copyright.h for copyright notice and limitation
+// of liability and disclaimer of warranty provisions.
+
+#include "copyright.h"
+#include "system.h"
+#include "addrspace.h"
+#include "noff.h"
+#include "syscall.h"
+#ifdef HOST_SPARC
+#include <strings.h>
+#endif
+
+//----------------------------------------------------------------------
+// SwapHeader
+// 	Do little endian to big endian conversion on the bytes in the
+//	object file header, in case the file was generated on a little
+//	endian machine, and we're now running on a big endian machine.
+//----------------------------------------------------------------------
+
+static void SwapHeader(NoffHeader *noffH) {
+	noffH->noffMagic = WordToHost(noffH->noffMagic);
+	noffH->code.size = WordToHost(noffH->code.size);
+	noffH->code.virtualAddr = WordToHost(noffH->code.virtualAddr);
+	noffH->code.inFileAddr = WordToHost(noffH->code.inFileAddr);
+	noffH->initData.size = WordToHost(noffH->initData.size);
+	noffH->initData.virtualAddr = WordToHost(noffH->initData.virtualAddr);
+	noffH->initData.inFileAddr = WordToHost(noffH->initData.inFileAddr);
+	noffH->uninitData.size = WordToHost(noffH->uninitData.size);
+	noffH->uninitData.virtualAddr = WordToHost(noffH->uninitData.virtualAddr);
+	noffH->uninitData.inFileAddr = WordToHost(noffH->uninitData.inFileAddr);
+}
+AddrSpace::AddrSpace(Thread* toCopy) {
+	// 内存映射区域不被子进程继承：子进程的地址空间到栈顶为止
+	mmapBase = toCopy->space->mmapBase;
+	numPages = mmapBase;
+	mmapRegions = new List();
+	for (int i = 0; i < MaxOpenFiles; i++) { // 子进程继承父进程的文件描述符
+		OpenFile *file = toCopy->space->files[i];
+		files[i] = (file == NULL) ? NULL : fileSystem->Dup(file);
+	}
+	pageTable = new TranslationEntry[numPages];
+	for (int i = 0; i < numPages; i++) {
+		if (toCopy->space->pageTable[i].codeData == TRUE) {
+			memcpy(&pageTable[i], &(toCopy->space->pageTable[i]),
+					sizeof(TranslationEntry));
+			if (pageTable[i].valid) { // 不与父进程共享物理页面，把当前内容拷贝到虚拟磁盘，由缺页处理装入
+				if (machine->pageTable == toCopy->space->pageTable)
+					machine->invalidateTlb(i); // 同步tlb中的dirty位
+				char *diskPage = new char[PageSize];
+				memcpy(diskPage,
+						machine->mainMemory + pageTable[i].physicalPage * PageSize,
+						PageSize);
+				machine->disk->Append((void*) diskPage);
+				pageTable[i].onDisk = TRUE;
+				pageTable[i].diskAddr = (int) diskPage;
+				pageTable[i].valid = FALSE;
+				pageTable[i].largePage = FALSE;
+				pageTable[i].dirty = FALSE;
+			}
+		}
+		pageTable[i].virtualPage = i;
+	}
+}
+//----------------------------------------------------------------------
+// AddrSpace::AddrSpace
+// 	Create an address space to run a user program.
+//	Load the program from a file "executable", and set everything
+//	up so that we can start executing user instructions.
+//
+//	Assumes that the object code file is in NOFF format.
+//
+//	First, set up the translation from program memory to physical
+//	memory.  For now, this is really simple (1:1), since we are
+//	only uniprogramming, and we have a single unsegmented page table
+//
+//	"executable" is the file containing the object code to load into memory
+//----------------------------------------------------------------------
+
+AddrSpace::AddrSpace(OpenFile *executable) {
+	NoffHeader noffH;
+	unsigned int i, size;
+
+	executable->ReadAt((char *) &noffH, sizeof(noffH), 0);
+	if ((noffH.noffMagic != NOFFMAGIC)
+			&& (WordToHost(noffH.noffMagic) == NOFFMAGIC))
+		SwapHeader(&noffH);
+	ASSERT(noffH.noffMagic == NOFFMAGIC);
+
+	// how big is address space?
+	size = noffH.code.size + noffH.initData.size + noffH.uninitData.size
+			+ UserStackSize; // we need to increase the size
+							 // to leave room for the stack
+	numPages = divRoundUp(size, PageSize);
+	size = numPages * PageSize;
+
+	ASSERT(numPages <= NumPhysPages); // check we're not trying
+									  // to run anything too big --
+									  // at least until we have
+									  // virtual memory
+
+	DEBUG('a', "Initializing address space, num pages %d, size %d\n", numPages,
+			size);
+	mmapBase = numPages;
+	mmapRegions = new List();
+	for (i = 0; i < MaxOpenFiles; i++)
+		files[i] = NULL;
+	// first, set up the translation
+	pageTable = new TranslationEntry[numPages];
+	for (i = 0; i < numPages; i++) {
+		pageTable[i].virtualPage = i;
+		pageTable[i].valid = FALSE;
+		pageTable[i].use = FALSE;
+		pageTable[i].dirty = FALSE;
+		pageTable[i].readOnly = FALSE;
+		pageTable[i].onDisk = FALSE;           // 不在磁盘上有缓存
+		pageTable[i].codeData = FALSE;
+	}
+
+	// 不清零主存
+	// zero out the entire address space, to zero the unitialized data segment
+	// and the stack segment
+	//   bzero(machine->mainMemory, size);
+
+	if (noffH.code.size > 0) {
+		DEBUG('a', "Initializing code segment, at 0x%x, size %d\n",
+				noffH.code.virtualAddr, noffH.code.size);
+		/* 将其加载至虚拟磁盘 */
+		unsigned codeVirAddr = (unsigned) noffH.code.virtualAddr;
+		unsigned int offset = codeVirAddr % PageSize;  //偏移
+		unsigned int vpn = codeVirAddr / PageSize;  //第一个虚拟页号
+		int codePages = divRoundUp(noffH.code.size + offset, PageSize); //总计需要的页面数量
+		int totalCodeSize = codePages * PageSize;    // 总计的代码所需页面大小
+		char* allDisk = new char[totalCodeSize];    //分配一个大块磁盘
+		bzero(allDisk, totalCodeSize);
+		executable->ReadAt(allDisk + offset, noffH.code.size,
+				noffH.code.inFileAddr);   //读取所有代码到磁盘上
+		for (int i = 0; i < codePages; i++) {     //将磁盘分割为小块映射到内存页
+
+			char* diskPage = allDisk + PageSize * i;
+			pageTable[vpn + i].onDisk = true;
+			pageTable[vpn + i].diskAddr = diskPage;
+			pageTable[vpn + i].codeData = TRUE;
+			machine->disk->Append((void*) diskPage);  //加入虚拟磁
+		}
+	}
+	if (noffH.initData.size > 0) {
+		DEBUG('a', "Initializing data segment, at 0x%x, size %d\n",
+				noffH.initData.virtualAddr, noffH.initData.size);
+		/* 将其加载至虚拟磁盘 */
+		unsigned dataVirAddr = (unsigned) noffH.initData.virtualAddr;
+		unsigned int offset = dataVirAddr % PageSize;  //偏移
+		unsigned int vpn = dataVirAddr / PageSize;  //第一个虚拟页号
+		int dataPages = divRoundUp(noffH.initData.size + offset, PageSize); //总计需要的页面数量
+		int totalDataSize = dataPages * PageSize;
+		char* allDisk = new char[totalDataSize];    //分配一个大块磁盘
+		bzero(allDisk, totalDataSize);
+		executable->ReadAt(allDisk + offset, noffH.initData.size,
+				noffH.initData.inFileAddr);   //读取所有数据到磁盘上
+		for (int i = 0; i < dataPages; i++) {   //  分割磁盘块
+			char* diskPage = allDisk + PageSize * i;
+			if (pageTable[vpn + i].onDisk == FALSE) {
+				pageTable[vpn + i].onDisk = true;
+				pageTable[vpn + i].diskAddr = diskPage;
+				pageTable[vpn + i].codeData = TRUE;
+				machine->disk->Append((void*) diskPage);  //加入虚拟磁盘
+			} else {    //拷贝到原来已经分配好的磁盘块
+				for (int j = 0; j < PageSize; j++) {
+					if (diskPage[j] != 0) {
+						((char*) (pageTable[vpn + i].diskAddr))[j] =
+								diskPage[j];
+					}
+				}
+			}
+
+		}
+	}
+
+	// 代码段和数据段在虚拟地址空间中是连续的，尽量使用大页面映射
+	if (machine->largePages) {
+		unsigned int segEnd = noffH.code.virtualAddr + noffH.code.size;
+		if (noffH.initData.size > 0)
+			segEnd = noffH.initData.virtualAddr + noffH.initData.size;
+		if (noffH.uninitData.size > 0)
+			segEnd = noffH.uninitData.virtualAddr + noffH.uninitData.size;
+		mapLargePages(noffH.code.virtualAddr / PageSize,
+				divRoundUp(segEnd, PageSize));
+	}
+}
+
+//----------------------------------------------------------------------
+// AddrSpace::mapLargePages
+// 	把[firstVpn, endVpn)内按LargePageFactor对齐的完整页面组映射为大页面：
+//	一次分配LargePageFactor个连续的物理页面，并立即把虚拟磁盘上的内容装入，
+//	这样一个TLB项就能覆盖整个大页面。没有足够的连续物理页面时，
+//	剩余的页面保持原来的按需调页方式（基本页面）。
+//----------------------------------------------------------------------
+
+void AddrSpace::mapLargePages(int firstVpn, int endVpn) {
+	int vpn = divRoundUp(firstVpn, LargePageFactor) * LargePageFactor;
+	for (; vpn + LargePageFactor <= endVpn; vpn += LargePageFactor) {
+		int base = machine->findLargePhyPage();
+		if (base == -1) {
+			DEBUG('a', "No contiguous frames for large page at vpn %d\n", vpn);
+			return;
+		}
+		DEBUG('a', "Mapping large page vpn %d -> frame %d\n", vpn, base);
+		for (int i = 0; i < LargePageFactor; i++) {
+			TranslationEntry *entry = &pageTable[vpn + i];
+			char *frame = machine->mainMemory + (base + i) * PageSize;
+			if (entry->onDisk)
+				memcpy(frame, (char*) entry->diskAddr, PageSize);
+			else
+				bzero(frame, PageSize);
+			entry->physicalPage = base + i;
+			entry->valid = TRUE;
+			entry->largePage = TRUE;
+		}
+	}
+}
+
+//----------------------------------------------------------------------
+// AddrSpace::~AddrSpace
+// 	Dealloate an address space.  释放仍在内存中的页面（包括大页面）占用的物理页面，
+//	物理页面只属于一个地址空间（fork时子进程会拷贝父进程的页面）。
+//----------------------------------------------------------------------
+
+AddrSpace::~AddrSpace() {
+	MunmapAll();
+	CloseAll();
+	for (int i = 0; i < numPages; i++) {
+		if (pageTable[i].valid)
+			machine->pageUsage[pageTable[i].physicalPage] = FALSE;
+	}
+	delete mmapRegions;
+	delete pageTable;
+}
+
+//----------------------------------------------------------------------
+// AddrSpace::Mmap
+// 	把打开的文件映射到栈上方的映射区，反回映射区域的起始虚拟地址。
+//	优先使用已解除映射留下的空闲页面段（首次适配），不够时才在末尾扩展页表。
+//	这里只建立页表项，不读取任何数据：页表项记录来源文件和页面在文件中的偏移，
+//	第一次访问时由缺页处理通过OpenFile::ReadPage从文件对应的扇区读入。
+//
+//	"file" -- 要映射的文件，解除映射时由地址空间负责关闭
+//----------------------------------------------------------------------
+
+int AddrSpace::Mmap(OpenFile *file) {
+	int length = file->Length();
+	if (length <= 0)
+		return -1;
+
+	int pages = divRoundUp(length, PageSize);
+	int firstVpn = findMmapGap(pages);
+	if (firstVpn + pages > numPages) {
+		TranslationEntry *newTable = new TranslationEntry[firstVpn + pages];
+		for (int i = 0; i < numPages; i++)
+			newTable[i] = pageTable[i];
+		for (int i = numPages; i < firstVpn + pages; i++)
+			newTable[i].virtualPage = i;
+		delete[] pageTable;
+		pageTable = newTable;
+		numPages = firstVpn + pages;
+	}
+	for (int i = 0; i < pages; i++) {
+		pageTable[firstVpn + i].mappedFile = file;
+		pageTable[firstVpn + i].fileOffset = i * PageSize;
+	}
+
+	MmapRegion *region = new MmapRegion;
+	region->file = file;
+	region->firstVpn = firstVpn;
+	region->numPages = pages;
+	mmapRegions->Append((void*) region);
+
+	RestoreState(); // 页表已经重新分配
+	DEBUG('a', "Mapped file at vpn %d, %d pages\n", firstVpn, pages);
+	return firstVpn * PageSize;
+}
+
+//----------------------------------------------------------------------
+// AddrSpace::findMmapGap
+// 	在映射区[mmapBase, numPages)中找第一段不属于任何映射区域的连续pages个页面，
+//	反回起始虚拟页号。没有足够大的空闲段时反回的页面段会超出numPages，
+//	由调用者扩展页表。
+//----------------------------------------------------------------------
+
+int AddrSpace::findMmapGap(int pages) {
+	int start = mmapBase;
+	bool moved = TRUE;
+	while (moved) {
+		moved = FALSE;
+		for (ListElement *e = mmapRegions->getHead(); e != NULL; e = e->next) {
+			MmapRegion *region = (MmapRegion*) e->item;
+			if (region->firstVpn < start + pages
+					&& start < region->firstVpn + region->numPages) {
+				start = region->firstVpn + region->numPages;
+				moved = TRUE;
+			}
+		}
+	}
+	return start;
+}
+
+//----------------------------------------------------------------------
+// AddrSpace::Munmap
+// 	解除从addr开始的映射：在内存中的脏页写回文件，释放物理页面，
+//	页表项恢复为未使用，最后关闭文件。解除的是最高的区域时缩小numPages，
+//	所以反复映射/解除映射不会让地址空间一直增长。
+//----------------------------------------------------------------------
+
+bool AddrSpace::Munmap(int addr) {
+	MmapRegion *region = NULL;
+	for (ListElement *e = mmapRegions->getHead(); e != NULL; e = e->next) {
+		if (((MmapRegion*) e->item)->firstVpn * PageSize == addr) {
+			region = (MmapRegion*) e->item;
+			break;
+		}
+	}
+	if (region == NULL)
+		return FALSE;
+
+	for (int vpn = region->firstVpn; vpn < region->firstVpn + region->numPages; vpn++) {
+		TranslationEntry *entry = &pageTable[vpn];
+		if (entry->valid) {
+			machine->invalidateTlb(vpn); // 同步tlb中的dirty位
+			if (entry->dirty)
+				region->file->WritePage(
+						machine->mainMemory + entry->physicalPage * PageSize,
+						entry->fileOffset);
+			machine->pageUsage[entry->physicalPage] = FALSE;
+		}
+		*entry = TranslationEntry(); // 空闲页面段可以被之后的Mmap重用
+		entry->virtualPage = vpn;
+	}
+	fileSystem->Close(region->file);
+	mmapRegions->Remove((void*) region);
+	delete region;
+
+	unsigned int end = mmapBase; // 剩余映射区域的最高页面之后
+	for (ListElement *e = mmapRegions->getHead(); e != NULL; e = e->next) {
+		MmapRegion *r = (MmapRegion*) e->item;
+		if (r->firstVpn + r->numPages > end)
+			end = r->firstVpn + r->numPages;
+	}
+	if (end < numPages) {
+		numPages = end; // 页表数组不必重新分配，多出的项已恢复为未使用
+		RestoreState();
+	}
+	return TRUE;
+}
+
+void AddrSpace::MunmapAll() {
+	while (!mmapRegions->IsEmpty()) {
+		MmapRegion *region = (MmapRegion*) mmapRegions->getHead()->item;
+		Munmap(region->firstVpn * PageSize);
+	}
+}
+
+//----------------------------------------------------------------------
+// AddrSpace::InitRegisters
+// 	Set the initial values for the user-level register set.
+//
+// 	We write these directly into the "machine" registers, so
+//	that we can immediately jump to user code.  Note that these
+//	will be saved/restored into the currentThread->userRegisters
+//	when this thread is context switched out.
+//----------------------------------------------------------------------
+
+void AddrSpace::InitRegisters() {
+	int i;
+
+	for (i = 0; i < NumTotalRegs; i++)
+		machine->WriteRegister(i, 0);
+
+	// Initial program counter -- must be location of "Start"
+	machine->WriteRegister(PCReg, 0);
+
+	// Need to also tell MIPS where next instruction is, because
+	// of branch delay possibility
+	machine->WriteRegister(NextPCReg, 4);
+
+	// Set the stack register to the end of the address space, where we
+	// allocated the stack; but subtract off a bit, to make sure we don't
+	// accidentally reference off the end!
+	machine->WriteRegister(StackReg, numPages * PageSize - 16);
+	DEBUG('a', "Initializing stack register to %d\n", numPages * PageSize - 16);
+}
+
+void AddrSpace::setPC(int func) {
+	machine->WriteRegister(PCReg, func);
+	machine->WriteRegister(NextPCReg, func + 4);
+}
+//----------------------------------------------------------------------
+// AddrSpace::SaveState
+// 	On a context switch, save any machine state, specific
+//	to this address space, that needs saving.
+//
+//	Write the TLB's dirty/use bits back to our page table, since
+//	RestoreState of the next space throws the TLB away.
+//----------------------------------------------------------------------
+
+void AddrSpace::SaveState() {
+	machine->flushTlb(); // 换出前把tlb中的dirty/use位写回本进程的页表
+}
+
+//----------------------------------------------------------------------
+// AddrSpace::RestoreState
+// 	On a context switch, restore the machine state so that
+//	this address space can run.
+//
+//      For now, tell the machine where to find the page table.
+//----------------------------------------------------------------------
+
+void AddrSpace::RestoreState() {
+	machine->pageTable = pageTable;
+	machine->pageTableSize = numPages;
+	if (machine->tlb != NULL) { // tlb的内容只对当前地址空间有效
+		for (int i = 0; i < TLBSize; i++)
+			machine->tlb[i].valid = FALSE;
+	}
+}
+
+//----------------------------------------------------------------------
+// AddrSpace::AllocFd/GetFile/RemoveFd
+// 	进程的文件描述符表。描述符是files数组的下标，直接指向打开文件，
+//	打开文件再指向系统打开文件表中的表项（文件头、锁和打开计数），
+//	所以每次读写只需要一次下标访问。0和1保留给控制台输入输出。
+//----------------------------------------------------------------------
+
+int AddrSpace::AllocFd(OpenFile *file) {
+	for (int fd = ConsoleOutput + 1; fd < MaxOpenFiles; fd++) {
+		if (files[fd] == NULL) {
+			files[fd] = file;
+			return fd;
+		}
+	}
+	return -1;
+}
+
+OpenFile *AddrSpace::GetFile(int fd) {
+	if (fd < 0 || fd >= MaxOpenFiles)
+		return NULL;
+	return files[fd];
+}
+
+OpenFile *AddrSpace::RemoveFd(int fd) {
+	OpenFile *file = GetFile(fd);
+	if (file != NULL)
+		files[fd] = NULL;
+	return file;
+}
+
+void AddrSpace::CloseAll() {
+	for (int fd = 0; fd < MaxOpenFiles; fd++) {
+		if (files[fd] != NULL)
+			fileSystem->Close(RemoveFd(fd));
+	}
+}
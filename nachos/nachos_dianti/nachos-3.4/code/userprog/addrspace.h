@@ -1,41 +1,67 @@
-// addrspace.h
-//	Data structures to keep track of executing user programs
-//	(address spaces).
-//
-//	For now, we don't keep any information about address spaces.
-//	The user level CPU state is saved and restored in the thread
-//	executing the user program (see thread.h).
-//
-// Copyright (c) 1992-1993 The Regents of the University of California.
-// All rights reserved.  See copyright.h for copyright notice and limitation
-// of liability and disclaimer of warranty provisions.
-
-#ifndef ADDRSPACE_H
-#define ADDRSPACE_H
-
-#include "copyright.h"
-#include "openfile.h"
-
-#define UserStackSize 1024 // increase this as necessary!
-class Thread;
-class AddrSpace {
-public:
-	AddrSpace(OpenFile *executable); // Create an address space,
-									 // initializing it with the program
-									 // stored in the file "executable"
-	AddrSpace(Thread *toCopy);
-	~AddrSpace(); // De-allocate an address space
-
-	void InitRegisters(); // Initialize user-level CPU registers,
-						  // before jumping to user code
-
-	void SaveState();    // Save/restore address space-specific
-	void RestoreState(); // info on a context switch
-	void setPC(int func);
-	TranslationEntry *pageTable; // Assume linear page table translation
-								 // for now!
-	unsigned int numPages;       // Number of pages in the virtual
-								 // address space
-};
-
-#endif // ADDRSPACE_H
+// addrspace.h
+//	Data structures to keep track of executing user programs
+//	(address spaces).
+//
+//	For now, we don't keep any information about address spaces.
+//	The user level CPU state is saved and restored in the thread
+//	executing the user program (see thread.h).
+//
+// Copyright (c) 1992-1993 The Regents of the University of California.
+// All rights reserved.  See copyright.h for copyright notice and limitation
+// of liability and disclaimer of warranty provisions.
+
+#ifndef ADDRSPACE_H
+#define ADDRSPACE_H
+
+#include "copyright.h"
+#include "openfile.h"
+#include "list.h"
+
+#define UserStackSize 1024 // increase this as necessary!
+class Thread;
+
+// 一段内存映射文件区域：虚拟页[firstVpn, firstVpn + numPages)映射到文件file
+class MmapRegion {
+public:
+	OpenFile *file;
+	int firstVpn;
+	int numPages;
+};
+
+#define MaxOpenFiles 16 // 每个进程最多同时打开的文件数
+
+class AddrSpace {
+public:
+	AddrSpace(OpenFile *executable); // Create an address space,
+									 // initializing it with the program
+									 // stored in the file "executable"
+	AddrSpace(Thread *toCopy);
+	~AddrSpace(); // De-allocate an address space
+
+	void InitRegisters(); // Initialize user-level CPU registers,
+						  // before jumping to user code
+
+	void SaveState();    // Save/restore address space-specific
+	void RestoreState(); // info on a context switch
+	void setPC(int func);
+	void mapLargePages(int firstVpn, int endVpn); // 用大页面映射[firstVpn, endVpn)中对齐的页面组
+
+	int Mmap(OpenFile *file); // 将文件映射到栈上方的映射区，反回起始虚拟地址
+	bool Munmap(int addr);	  // 解除addr处的映射，写回脏页
+	void MunmapAll();		  // 进程退出时解除所有映射
+	int findMmapGap(int pages); // 映射区中第一段足够大的空闲页面段的起始页号
+
+	int AllocFd(OpenFile *file); // 为打开文件分配最小的空闲描述符，满时返回-1
+	OpenFile *GetFile(int fd);	 // 描述符对应的打开文件，无效时返回NULL
+	OpenFile *RemoveFd(int fd);	 // 释放描述符，返回原来的打开文件
+	void CloseAll();			 // 进程退出时关闭所有打开文件
+	TranslationEntry *pageTable; // Assume linear page table translation
+								 // for now!
+	unsigned int numPages;       // Number of pages in the virtual
+								 // address space
+	unsigned int mmapBase;       // 映射区从这一页开始（栈的上方）
+	List *mmapRegions;           // 当前的内存映射文件区域，fork时不被子进程继承
+	OpenFile *files[MaxOpenFiles]; // 进程的文件描述符表，0和1保留给控制台
+};
+
+#endif // ADDRSPACE_H
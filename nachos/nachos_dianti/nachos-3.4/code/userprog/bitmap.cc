@@ -1,165 +1,299 @@
-// bitmap.c 
-//	Routines to manage a bitmap -- an array of bits each of which
-//	can be either on or off.  Represented as an array of integers.
-//
-// Copyright (c) 1992-1993 The Regents of the University of California.
-// All rights reserved.  See copyright.h for copyright notice and limitation 
-// of liability and disclaimer of warranty provisions.
-
-#include "copyright.h"
-#include "bitmap.h"
-
-//----------------------------------------------------------------------
-// BitMap::BitMap
-// 	Initialize a bitmap with "nitems" bits, so that every bit is clear.
-//	it can be added somewhere on a list.
-//
-//	"nitems" is the number of bits in the bitmap.
-//----------------------------------------------------------------------
-
-BitMap::BitMap(int nitems) 
-{ 
-    numBits = nitems;
-    numWords = divRoundUp(numBits, BitsInWord);
-    map = new unsigned int[numWords];
-    for (int i = 0; i < numBits; i++) 
-        Clear(i);
-}
-
-//----------------------------------------------------------------------
-// BitMap::~BitMap
-// 	De-allocate a bitmap.
-//----------------------------------------------------------------------
-
-BitMap::~BitMap()
-{ 
-    delete map;
-}
-
-//----------------------------------------------------------------------
-// BitMap::Set
-// 	Set the "nth" bit in a bitmap.
-//
-//	"which" is the number of the bit to be set.
-//----------------------------------------------------------------------
-
-void
-BitMap::Mark(int which) 
-{ 
-    ASSERT(which >= 0 && which < numBits);
-    map[which / BitsInWord] |= 1 << (which % BitsInWord);
-}
-    
-//----------------------------------------------------------------------
-// BitMap::Clear
-// 	Clear the "nth" bit in a bitmap.
-//
-//	"which" is the number of the bit to be cleared.
-//----------------------------------------------------------------------
-
-void 
-BitMap::Clear(int which) 
-{
-    ASSERT(which >= 0 && which < numBits);
-    map[which / BitsInWord] &= ~(1 << (which % BitsInWord));
-}
-
-//----------------------------------------------------------------------
-// BitMap::Test
-// 	Return TRUE if the "nth" bit is set.
-//
-//	"which" is the number of the bit to be tested.
-//----------------------------------------------------------------------
-
-bool 
-BitMap::Test(int which)
-{
-    ASSERT(which >= 0 && which < numBits);
-    
-    if (map[which / BitsInWord] & (1 << (which % BitsInWord)))
-	return TRUE;
-    else
-	return FALSE;
-}
-
-//----------------------------------------------------------------------
-// BitMap::Find
-// 	Return the number of the first bit which is clear.
-//	As a side effect, set the bit (mark it as in use).
-//	(In other words, find and allocate a bit.)
-//
-//	If no bits are clear, return -1.
-//----------------------------------------------------------------------
-
-int 
-BitMap::Find() 
-{
-    for (int i = 0; i < numBits; i++)
-	if (!Test(i)) {
-	    Mark(i);
-	    return i;
-	}
-    return -1;
-}
-
-//----------------------------------------------------------------------
-// BitMap::NumClear
-// 	Return the number of clear bits in the bitmap.
-//	(In other words, how many bits are unallocated?)
-//----------------------------------------------------------------------
-
-int 
-BitMap::NumClear() 
-{
-    int count = 0;
-
-    for (int i = 0; i < numBits; i++)
-	if (!Test(i)) count++;
-    return count;
-}
-
-//----------------------------------------------------------------------
-// BitMap::Print
-// 	Print the contents of the bitmap, for debugging.
-//
-//	Could be done in a number of ways, but we just print the #'s of
-//	all the bits that are set in the bitmap.
-//----------------------------------------------------------------------
-
-void
-BitMap::Print() 
-{
-    printf("Bitmap set:\n"); 
-    for (int i = 0; i < numBits; i++)
-	if (Test(i))
-	    printf("%d, ", i);
-    printf("\n"); 
-}
-
-// These aren't needed until the FILESYS assignment
-
-//----------------------------------------------------------------------
-// BitMap::FetchFromFile
-// 	Initialize the contents of a bitmap from a Nachos file.
-//
-//	"file" is the place to read the bitmap from
-//----------------------------------------------------------------------
-
-void
-BitMap::FetchFrom(OpenFile *file) 
-{
-    file->ReadAt((char *)map, numWords * sizeof(unsigned), 0);
-}
-
-//----------------------------------------------------------------------
-// BitMap::WriteBack
-// 	Store the contents of a bitmap to a Nachos file.
-//
-//	"file" is the place to write the bitmap to
-//----------------------------------------------------------------------
-
-void
-BitMap::WriteBack(OpenFile *file)
-{
-   file->WriteAt((char *)map, numWords * sizeof(unsigned), 0);
-}
+// bitmap.c 
+//	Routines to manage a bitmap -- an array of bits each of which
+//	can be either on or off.  Represented as an array of integers.
+//
+// Copyright (c) 1992-1993 The Regents of the University of California.
+// All rights reserved.  See copyright.h for copyright notice and limitation 
+// of liability and disclaimer of warranty provisions.
+
+#include "copyright.h"
+#include "bitmap.h"
+#include "disk.h"
+
+// which sector of the bitmap's storage holds word "w"
+#define WordToChunk(w) 	((w) * (int) sizeof(unsigned) / SectorSize)
+
+//----------------------------------------------------------------------
+// BitMap::BitMap
+// 	Initialize a bitmap with "nitems" bits, so that every bit is clear.
+//	it can be added somewhere on a list.
+//
+//	"nitems" is the number of bits in the bitmap.
+//----------------------------------------------------------------------
+
+BitMap::BitMap(int nitems) 
+{ 
+    numBits = nitems;
+    numWords = divRoundUp(numBits, BitsInWord);
+    map = new unsigned int[numWords];
+    for (int i = 0; i < numWords; i++) 
+        map[i] = 0;
+    hint = 0;
+    numChunks = divRoundUp(numWords * sizeof(unsigned), SectorSize);
+    chunkDirty = new bool[numChunks];
+    for (int i = 0; i < numChunks; i++)	// nothing is on disk yet
+        chunkDirty[i] = TRUE;
+}
+
+//----------------------------------------------------------------------
+// BitMap::~BitMap
+// 	De-allocate a bitmap.
+//----------------------------------------------------------------------
+
+BitMap::~BitMap()
+{ 
+    delete [] map;
+    delete [] chunkDirty;
+}
+
+//----------------------------------------------------------------------
+// BitMap::Set
+// 	Set the "nth" bit in a bitmap.
+//
+//	"which" is the number of the bit to be set.
+//----------------------------------------------------------------------
+
+void
+BitMap::Mark(int which) 
+{ 
+    ASSERT(which >= 0 && which < numBits);
+    map[which / BitsInWord] |= 1 << (which % BitsInWord);
+    chunkDirty[WordToChunk(which / BitsInWord)] = TRUE;
+}
+    
+//----------------------------------------------------------------------
+// BitMap::Clear
+// 	Clear the "nth" bit in a bitmap.
+//
+//	"which" is the number of the bit to be cleared.
+//----------------------------------------------------------------------
+
+void 
+BitMap::Clear(int which) 
+{
+    ASSERT(which >= 0 && which < numBits);
+    map[which / BitsInWord] &= ~(1 << (which % BitsInWord));
+    chunkDirty[WordToChunk(which / BitsInWord)] = TRUE;
+}
+
+//----------------------------------------------------------------------
+// BitMap::Test
+// 	Return TRUE if the "nth" bit is set.
+//
+//	"which" is the number of the bit to be tested.
+//----------------------------------------------------------------------
+
+bool 
+BitMap::Test(int which)
+{
+    ASSERT(which >= 0 && which < numBits);
+    
+    if (map[which / BitsInWord] & (1 << (which % BitsInWord)))
+	return TRUE;
+    else
+	return FALSE;
+}
+
+//----------------------------------------------------------------------
+// BitMap::Find
+// 	Return the number of a bit which is clear.
+//	As a side effect, set the bit (mark it as in use).
+//	(In other words, find and allocate a bit.)
+//
+//	The search skips whole words that are full, starting from the
+//	word where the last search succeeded and wrapping around, and
+//	takes the lowest clear bit of the first word that has one.
+//
+//	If no bits are clear, return -1.
+//----------------------------------------------------------------------
+
+int 
+BitMap::Find() 
+{
+    for (int n = 0; n < numWords; n++) {
+	int w = (hint + n) % numWords;
+	unsigned int free = ~map[w];
+
+	if (free == 0)
+	    continue;			// word is full
+	int which = w * BitsInWord + __builtin_ctz(free);
+	if (which >= numBits)
+	    continue;			// only the padding of the last word
+	Mark(which);
+	hint = w;
+	return which;
+    }
+    return -1;
+}
+
+//----------------------------------------------------------------------
+// BitMap::FindRun
+// 	Best-fit search for a run of "want" consecutive clear bits.  The
+//	smallest run that is long enough is taken (its first "want" bits
+//	are set); if no run is long enough, the longest run is taken whole.
+//	Full words are skipped a word at a time, and so are empty words in
+//	the middle of a run.
+//
+//	Return the number of the first bit, with the number of bits set in
+//	"*got", or -1 if no bits are clear.
+//----------------------------------------------------------------------
+
+int
+BitMap::FindRun(int want, int *got)
+{
+    int best = -1, bestLen = 0;		// smallest run that is long enough
+    int big = -1, bigLen = 0;		// longest run
+    int i = 0;
+
+    while (i < numBits) {
+	if (i % BitsInWord == 0 && map[i / BitsInWord] == ~0u) {
+	    i += BitsInWord;
+	    continue;
+	}
+	if (Test(i)) {
+	    i++;
+	    continue;
+	}
+	int start = i;
+	while (i < numBits && !Test(i)) {
+	    if (i % BitsInWord == 0 && map[i / BitsInWord] == 0
+		    && i + BitsInWord <= numBits)
+		i += BitsInWord;
+	    else
+		i++;
+	}
+	int len = i - start;
+	if (len >= want && (best == -1 || len < bestLen)) {
+	    best = start;
+	    bestLen = len;
+	    if (len == want)
+		break;			// can't do better than exact
+	}
+	if (len > bigLen) {
+	    big = start;
+	    bigLen = len;
+	}
+    }
+    if (best == -1) {
+	if (big == -1)
+	    return -1;
+	best = big;
+	want = bigLen;
+    }
+    for (int j = 0; j < want; j++)
+	Mark(best + j);
+    *got = want;
+    return best;
+}
+
+//----------------------------------------------------------------------
+// BitMap::MarkRun
+// 	Set the clear bits from "start" on, up to "want" of them, stopping
+//	at the first bit that is already set.  Return how many were set.
+//----------------------------------------------------------------------
+
+int
+BitMap::MarkRun(int start, int want)
+{
+    int count = 0;
+
+    while (count < want && start + count < numBits && !Test(start + count)) {
+	Mark(start + count);
+	count++;
+    }
+    return count;
+}
+
+//----------------------------------------------------------------------
+// BitMap::NumClear
+// 	Return the number of clear bits in the bitmap.
+//	(In other words, how many bits are unallocated?)
+//----------------------------------------------------------------------
+
+int 
+BitMap::NumClear() 
+{
+    int count = 0;
+
+    for (int i = 0; i < numWords; i++)	// bits past numBits are never set
+	count += __builtin_popcount(map[i]);
+    return numBits - count;
+}
+
+//----------------------------------------------------------------------
+// BitMap::Print
+// 	Print the contents of the bitmap, for debugging.
+//
+//	Could be done in a number of ways, but we just print the #'s of
+//	all the bits that are set in the bitmap.
+//----------------------------------------------------------------------
+
+void
+BitMap::Print() 
+{
+    printf("Bitmap set:\n"); 
+    for (int i = 0; i < numBits; i++)
+	if (Test(i))
+	    printf("%d, ", i);
+    printf("\n"); 
+}
+
+// These aren't needed until the FILESYS assignment
+
+//----------------------------------------------------------------------
+// BitMap::FetchFromFile
+// 	Initialize the contents of a bitmap from a Nachos file.
+//
+//	"file" is the place to read the bitmap from
+//----------------------------------------------------------------------
+
+void
+BitMap::FetchFrom(OpenFile *file) 
+{
+    file->ReadAt((char *)map, numWords * sizeof(unsigned), 0);
+    for (int i = 0; i < numChunks; i++)
+	chunkDirty[i] = FALSE;
+}
+
+//----------------------------------------------------------------------
+// BitMap::MarkZeroOnDisk
+// 	The file the bitmap will be written to is known to contain only
+//	zeros (for the free map, the disk has just been created).  Sectors
+//	of the bitmap with no bits set are already right on disk, so they
+//	are left for the first WriteBack after something in them changes.
+//	This is what makes formatting a large disk fast.
+//----------------------------------------------------------------------
+
+void
+BitMap::MarkZeroOnDisk()
+{
+    for (int i = 0; i < numChunks; i++)
+	chunkDirty[i] = FALSE;
+    for (int i = 0; i < numWords; i++)
+	if (map[i] != 0)
+	    chunkDirty[WordToChunk(i)] = TRUE;
+}
+
+//----------------------------------------------------------------------
+// BitMap::WriteBack
+// 	Store the contents of a bitmap to a Nachos file.  Only the sectors
+//	of the bitmap changed since it was last fetched or written back
+//	are written.
+//
+//	"file" is the place to write the bitmap to
+//----------------------------------------------------------------------
+
+void
+BitMap::WriteBack(OpenFile *file)
+{
+    int size = numWords * sizeof(unsigned);
+
+    for (int i = 0; i < numChunks; i++) {
+	if (!chunkDirty[i])
+	    continue;
+	int len = (size - i * SectorSize < SectorSize) ? size - i * SectorSize
+						       : SectorSize;
+	file->WriteAt((char *)map + i * SectorSize, len, i * SectorSize);
+	chunkDirty[i] = FALSE;
+    }
+}
@@ -1,64 +1,90 @@
-// bitmap.h 
-//	Data structures defining a bitmap -- an array of bits each of which
-//	can be either on or off.
-//
-//	Represented as an array of unsigned integers, on which we do
-//	modulo arithmetic to find the bit we are interested in.
-//
-//	The bitmap can be parameterized with with the number of bits being 
-//	managed.
-//
-// Copyright (c) 1992-1993 The Regents of the University of California.
-// All rights reserved.  See copyright.h for copyright notice and limitation 
-// of liability and disclaimer of warranty provisions.
-
-#ifndef BITMAP_H
-#define BITMAP_H
-
-#include "copyright.h"
-#include "utility.h"
-#include "openfile.h"
-
-// Definitions helpful for representing a bitmap as an array of integers
-#define BitsInByte 	8
-#define BitsInWord 	32
-
-// The following class defines a "bitmap" -- an array of bits,
-// each of which can be independently set, cleared, and tested.
-//
-// Most useful for managing the allocation of the elements of an array --
-// for instance, disk sectors, or main memory pages.
-// Each bit represents whether the corresponding sector or page is
-// in use or free.
-
-class BitMap {
-  public:
-    BitMap(int nitems);		// Initialize a bitmap, with "nitems" bits
-				// initially, all bits are cleared.
-    ~BitMap();			// De-allocate bitmap
-    
-    void Mark(int which);   	// Set the "nth" bit
-    void Clear(int which);  	// Clear the "nth" bit
-    bool Test(int which);   	// Is the "nth" bit set?
-    int Find();            	// Return the # of a clear bit, and as a side
-				// effect, set the bit. 
-				// If no bits are clear, return -1.
-    int NumClear();		// Return the number of clear bits
-
-    void Print();		// Print contents of bitmap
-    
-    // These aren't needed until FILESYS, when we will need to read and 
-    // write the bitmap to a file
-    void FetchFrom(OpenFile *file); 	// fetch contents from disk 
-    void WriteBack(OpenFile *file); 	// write contents to disk
-
-  private:
-    int numBits;			// number of bits in the bitmap
-    int numWords;			// number of words of bitmap storage
-					// (rounded up if numBits is not a
-					//  multiple of the number of bits in
-					//  a word)
-    unsigned int *map;			// bit storage
-};
-
-#endif // BITMAP_H
+// bitmap.h 
+//	Data structures defining a bitmap -- an array of bits each of which
+//	can be either on or off.
+//
+//	Represented as an array of unsigned integers, on which we do
+//	modulo arithmetic to find the bit we are interested in.
+//
+//	The bitmap can be parameterized with with the number of bits being 
+//	managed.
+//
+//	Find and NumClear work a word at a time; Find is next-fit, starting
+//	from the word where the previous search succeeded.  Mark and Clear
+//	remember which sector-sized pieces of the bitmap they changed, so
+//	WriteBack only writes those.  A bitmap stored in a file known to be
+//	all zeros (a freshly created disk) can skip writing the pieces that
+//	are still all clear, see MarkZeroOnDisk.
+//
+// Copyright (c) 1992-1993 The Regents of the University of California.
+// All rights reserved.  See copyright.h for copyright notice and limitation 
+// of liability and disclaimer of warranty provisions.
+
+#ifndef BITMAP_H
+#define BITMAP_H
+
+#include "copyright.h"
+#include "utility.h"
+#include "openfile.h"
+
+// Definitions helpful for representing a bitmap as an array of integers
+#define BitsInByte 	8
+#define BitsInWord 	32
+
+// The following class defines a "bitmap" -- an array of bits,
+// each of which can be independently set, cleared, and tested.
+//
+// Most useful for managing the allocation of the elements of an array --
+// for instance, disk sectors, or main memory pages.
+// Each bit represents whether the corresponding sector or page is
+// in use or free.
+
+class BitMap {
+  public:
+    BitMap(int nitems);		// Initialize a bitmap, with "nitems" bits
+				// initially, all bits are cleared.
+    ~BitMap();			// De-allocate bitmap
+    
+    void Mark(int which);   	// Set the "nth" bit
+    void Clear(int which);  	// Clear the "nth" bit
+    bool Test(int which);   	// Is the "nth" bit set?
+    int Find();            	// Return the # of a clear bit, and as a side
+				// effect, set the bit. 
+				// If no bits are clear, return -1.
+				// Searching starts where the last
+				// search left off (next-fit).
+    int NumClear();		// Return the number of clear bits
+    int FindRun(int want, int *got);
+				// Find and set a run of clear bits: the
+				// smallest run of at least "want" bits,
+				// or else the largest run there is.
+				// Return the first bit, and the number
+				// of bits set in *got; -1 if none clear
+    int MarkRun(int start, int want);
+				// Set up to "want" clear bits from
+				// "start" on, stopping at the first set
+				// one; return how many were set
+
+    void Print();		// Print contents of bitmap
+    
+    // These aren't needed until FILESYS, when we will need to read and 
+    // write the bitmap to a file
+    void FetchFrom(OpenFile *file); 	// fetch contents from disk 
+    void WriteBack(OpenFile *file); 	// write changed sectors to disk
+    void MarkZeroOnDisk();		// the file already holds all zeros:
+					// only sectors with bits set need
+					// to be written
+
+  private:
+    int numBits;			// number of bits in the bitmap
+    int numWords;			// number of words of bitmap storage
+					// (rounded up if numBits is not a
+					//  multiple of the number of bits in
+					//  a word)
+    unsigned int *map;			// bit storage
+    int hint;				// word where the next Find starts
+    int numChunks;			// number of sectors of bit storage
+    bool *chunkDirty;			// sectors changed since the last
+					// FetchFrom/WriteBack
+};
+
+#endif // BITMAP_H
@@ -1,200 +1,506 @@
-// exception.cc
-//	Entry point into the Nachos kernel from user programs.
-//	There are two kinds of things that can cause control to
-//	transfer back to here from user code:
-//
-//	syscall -- The user code explicitly requests to call a procedure
-//	in the Nachos kernel.  Right now, the only function we support is
-//	"Halt".
-//
-//	exceptions -- The user code does something that the CPU can't handle.
-//	For instance, accessing memory that doesn't exist, arithmetic errors,
-//	etc.
-//
-//	Interrupts (which can also cause control to transfer from user
-//	code into the Nachos kernel) are handled elsewhere.
-//
-// For now, this only handles the Halt() system call.
-// Everything else core dumps.
-//
-// Copyright (c) 1992-1993 The Regents of the University of California.
-// All rights reserved.  See copyright.h for copyright notice and limitation
-// of liability and disclaimer of warranty provisions.
-
-#include "copyright.h"
-#include "system.h"
-#include "syscall.h"
-
-///*  for coding */
-#include "machine.h"
-#include "filesys.h"
-
-extern Machine *machine;
-extern FileSystem* fileSystem;
-extern void StartProcess(char *filename);
-extern void StartForkProcess(int func);
-//----------------------------------------------------------------------
-// ExceptionHandler
-// 	Entry point into the Nachos kernel.  Called when a user program
-//	is executing, and either does a syscall, or generates an addressing
-//	or arithmetic exception.
-//
-// 	For system calls, the following is the calling convention:
-//
-// 	system call code -- r2
-//		arg1 -- r4
-//		arg2 -- r5
-//		arg3 -- r6
-//		arg4 -- r7
-//
-//	The result of the system call, if any, must be put back into r2.
-//
-// And don't forget to increment the pc before returning. (Or else you'll
-// loop making the same system call forever!
-//
-//	"which" is the kind of exception.  The list of possible exceptions
-//	are in machine.h.
-//----------------------------------------------------------------------
-int translateAddr(int vaddr) {
-	int faddr = 0;
-	machine->ReadMem(vaddr, 4, &faddr);
-	machine->Translate(vaddr, &faddr, 4, FALSE);
-//	printf("translating vaddr %x to faddr %x\n", vaddr,
-//			machine->mainMemory + faddr);
-	return machine->mainMemory + faddr;
-}
-
-void SyscallHandler(int type) {
-	switch (type) {
-	case SC_Halt: {
-		DEBUG('a', "Shutdown, initiated by user program.\n");
-		interrupt->Halt();
-		break;
-	}
-	case SC_Exit: {
-//		printf("thread : %d is exit , Exit code is %d\n",currentThread->getTid(),
-//				machine->ReadRegister(4));
-
-		IntStatus oldLevel = interrupt->SetLevel(IntOff);
-		while (!currentThread->waitingList->IsEmpty()) {
-			Thread *t = (Thread *) currentThread->waitingList->Remove();
-			if (t != NULL) {
-				t->exitCode = machine->ReadRegister(4);
-				scheduler->ReadyToRun(t);
-			}
-		}
-		interrupt->SetLevel(oldLevel);
-
-		currentThread->Finish();
-		break;
-	}
-	case SC_Exec: {
-		char* name = (char*) translateAddr(machine->ReadRegister(4));
-		Thread* exec = new Thread("thread2");
-		exec->Fork(StartProcess, (void*) name);
-		machine->WriteRegister(2, exec->getTid());
-//		printf("execing prog %s, tid is :%d\n", name, exec->getTid());
-		break;
-	}
-	case SC_Fork: {
-		int func = machine->ReadRegister(4);
-
-		Thread* fork = new Thread("fork");
-
-		fork->StackAllocate(StartForkProcess, func);
-
-		AddrSpace* newspace = new AddrSpace(currentThread);
-		fork->space = newspace;
-
-//		printf("forking func addr %x in thread : %d\n", func, currentThread->getTid());
-		scheduler->ReadyToRun(fork);
-		break;
-	}
-	case SC_Yield: {
-//		printf("yield thread : %d\n", currentThread->getTid());
-		currentThread->Yield();
-		break;
-	}
-	case SC_Join: {
-		int tid = machine->ReadRegister(4);
-		Thread* waitFor = scheduler->getThreadByTid(tid);
-		waitFor->waitingList->Append((void*) currentThread);
-
-//		printf("thread %d join thread %d\n", currentThread->getTid(),
-//				waitFor->getTid());
-
-		IntStatus oldLevel = interrupt->SetLevel(IntOff);
-		currentThread->Sleep();
-		interrupt->SetLevel(oldLevel);
-
-		machine->WriteRegister(2, currentThread->exitCode);
-		break;
-	}
-	case SC_Create: {
-		char* name = (char*) translateAddr(machine->ReadRegister(4));
-		fileSystem->Create(name, 0, TRUE);
-//		machine->WriteRegister(PCReg, machine->ReadRegister(NextPCReg));
-		break;
-	}
-	case SC_Open: {
-		char* name = (char*) translateAddr(machine->ReadRegister(4));
-		OpenFile* openfile = fileSystem->Open(name);
-		machine->WriteRegister(2, (int) openfile);
-//		machine->WriteRegister(PCReg, machine->ReadRegister(NextPCReg));
-		break;
-	}
-	case SC_Close: {
-		int fileAddr = machine->ReadRegister(4);
-		fileSystem->Close((OpenFile*) fileAddr);
-//		machine->WriteRegister(PCReg, machine->ReadRegister(NextPCReg));
-		break;
-	}
-	case SC_Write: {
-		char* name = (char*) translateAddr(machine->ReadRegister(4));
-		int size = machine->ReadRegister(5);
-		OpenFile* file = (OpenFile*) machine->ReadRegister(6);
-
-		fileSystem->fwrite(file, name, size);
-//		machine->WriteRegister(PCReg, machine->ReadRegister(NextPCReg));
-		break;
-	}
-	case SC_Read: {
-		char* name = (char*) translateAddr(machine->ReadRegister(4));
-		int size = machine->ReadRegister(5);
-		OpenFile* file = (OpenFile*) machine->ReadRegister(6);
-
-		int num = fileSystem->fread(file, name, size);
-		machine->WriteRegister(2, num);
-//		machine->WriteRegister(PCReg, machine->ReadRegister(NextPCReg));
-		break;
-	}
-	default:{
-		printf("wrong syscall type %d\n", type);
-		ASSERT(FALSE);
-	}
-	}
-
-}
-void ExceptionHandler(ExceptionType which) {
-	int type = machine->ReadRegister(2);
-
-	if (which == SyscallException) {
-		return SyscallHandler(type);
-	} else if (which == PageFaultException) {
-		/*
-		 虚拟内存缺页中断。
-		 1.对于TLB， 用需要替换的地址替换TLB中现有的某一项，应该查询页表找到对应项，再利用选择算法替换某一项
-		 2.对于页表，需要将对应的磁盘数据读取至内存，为其分配一个物理内存，并在页表中添加其转换关系。
-		 */
-		int badAddr = machine->ReadRegister(BadVAddrReg);
-		DEBUG('a', "Page fault exception of addr %x.\n", badAddr);
-		if (machine->tlb != NULL) { //使用tlb
-			machine->replaceTlb(badAddr);
-		} else {
-			machine->replacePageTable(badAddr);
-		}
-	} else {
-		printf("Unexpected user mode exception %d %d\n", which, type);
-		ASSERT(FALSE);
-	}
-}
+// exception.cc
+//	Entry point into the Nachos kernel from user programs.
+//	There are two kinds of things that can cause control to
+//	transfer back to here from user code:
+//
+//	syscall -- The user code explicitly requests to call a procedure
+//	in the Nachos kernel.  Right now, the only function we support is
+//	"Halt".
+//
+//	exceptions -- The user code does something that the CPU can't handle.
+//	For instance, accessing memory that doesn't exist, arithmetic errors,
+//	etc.
+//
+//	Interrupts (which can also cause control to transfer from user
+//	code into the Nachos kernel) are handled elsewhere.
+//
+// For now, this only handles the Halt() system call.
+// Everything else core dumps.
+//
+// Copyright (c) 1992-1993 The Regents of the University of California.
+// All rights reserved.  See copyright.h for copyright notice and limitation
+// of liability and disclaimer of warranty provisions.
+
+#include "copyright.h"
+#include "system.h"
+#include "syscall.h"
+
+///*  for coding */
+#include "machine.h"
+#include "filesys.h"
+
+extern Machine *machine;
+extern FileSystem* fileSystem;
+extern void StartForkProcess(int func);
+//----------------------------------------------------------------------
+// ExceptionHandler
+// 	Entry point into the Nachos kernel.  Called when a user program
+//	is executing, and either does a syscall, or generates an addressing
+//	or arithmetic exception.
+//
+// 	For system calls, the following is the calling convention:
+//
+// 	system call code -- r2
+//		arg1 -- r4
+//		arg2 -- r5
+//		arg3 -- r6
+//		arg4 -- r7
+//
+//	The result of the system call, if any, must be put back into r2.
+//
+// And don't forget to increment the pc before returning. (Or else you'll
+// loop making the same system call forever!
+//
+//	"which" is the kind of exception.  The list of possible exceptions
+//	are in machine.h.
+//----------------------------------------------------------------------
+#define MaxUserString 256 // 从用户空间拷贝的文件名/路径的最大长度
+
+//----------------------------------------------------------------------
+// HandlePageFault
+// 	处理badAddr所在页面的缺页：使用tlb时先填充tlb，页面不在内存中
+//	再调入页面；否则直接调入页面。用户程序的缺页异常和内核访问用户
+//	内存时的缺页都由这里处理。
+//----------------------------------------------------------------------
+static void HandlePageFault(int badAddr) {
+	if (machine->tlb != NULL) { //使用tlb
+		stats->numTlbMisses++;
+		if (machine->replaceTlb(badAddr) == PageFaultException) {
+			// 页面不在内存中，先调入页面再填充tlb
+			machine->replacePageTable(badAddr);
+			machine->replaceTlb(badAddr);
+		}
+	} else {
+		machine->replacePageTable(badAddr);
+	}
+}
+
+//----------------------------------------------------------------------
+// UserToPhys
+// 	把用户虚拟地址转换为物理地址，页面不在内存中时先调入。
+//	地址非法（越界、写只读页）时返回-1。
+//----------------------------------------------------------------------
+static int UserToPhys(int vaddr, bool writing) {
+	int physAddr;
+	if ((unsigned) vaddr / PageSize >= machine->pageTableSize)
+		return -1;
+	for (;;) {
+		ExceptionType exception = machine->Translate(vaddr, &physAddr, 1, writing);
+		if (exception == NoException)
+			return physAddr;
+		if (exception != PageFaultException)
+			return -1;
+		HandlePageFault(vaddr);
+	}
+}
+
+//----------------------------------------------------------------------
+// CopyIn/CopyOut
+// 	在内核缓冲区和用户空间之间拷贝size字节。用户缓冲区可能跨越多个页面，
+//	而相邻的虚拟页面不一定对应相邻的物理页面，所以按页面逐段转换，
+//	每个页面只做一次memcpy。成功返回TRUE，遇到非法地址返回FALSE。
+//----------------------------------------------------------------------
+bool CopyIn(int vaddr, char *buf, int size) {
+	while (size > 0) {
+		int physAddr = UserToPhys(vaddr, FALSE);
+		if (physAddr < 0)
+			return FALSE;
+		int n = PageSize - vaddr % PageSize; // 本页内剩余的字节数
+		if (n > size)
+			n = size;
+		memcpy(buf, machine->mainMemory + physAddr, n);
+		vaddr += n;
+		buf += n;
+		size -= n;
+	}
+	return TRUE;
+}
+
+bool CopyOut(int vaddr, char *buf, int size) {
+	while (size > 0) {
+		int physAddr = UserToPhys(vaddr, TRUE);
+		if (physAddr < 0)
+			return FALSE;
+		int n = PageSize - vaddr % PageSize;
+		if (n > size)
+			n = size;
+		memcpy(machine->mainMemory + physAddr, buf, n);
+		vaddr += n;
+		buf += n;
+		size -= n;
+	}
+	return TRUE;
+}
+
+//----------------------------------------------------------------------
+// CopyInString
+// 	从用户空间拷贝以'\0'结尾的字符串，最多maxLen字节（包括'\0'）。
+//	返回字符串长度，地址非法或字符串太长时返回-1。
+//----------------------------------------------------------------------
+int CopyInString(int vaddr, char *buf, int maxLen) {
+	int len = 0;
+	while (len < maxLen) {
+		int physAddr = UserToPhys(vaddr, FALSE);
+		if (physAddr < 0)
+			return -1;
+		int n = PageSize - vaddr % PageSize;
+		if (n > maxLen - len)
+			n = maxLen - len;
+		char *from = machine->mainMemory + physAddr;
+		char *end = (char*) memchr(from, '\0', n);
+		if (end != NULL) {
+			memcpy(buf + len, from, end - from + 1);
+			return len + (end - from);
+		}
+		memcpy(buf + len, from, n);
+		vaddr += n;
+		len += n;
+	}
+	return -1;
+}
+
+//----------------------------------------------------------------------
+// MaxUserBuffer
+// 	用户缓冲区不可能比整个地址空间还大。内核按用户给出的长度分配缓冲区，
+//	所以先用它检查长度，否则一个很大的长度就会让内核分配失败而退出。
+//----------------------------------------------------------------------
+static int MaxUserBuffer() {
+	return currentThread->space->numPages * PageSize;
+}
+
+//----------------------------------------------------------------------
+// CopyInIoVec
+// 	读入ReadV/WriteV的IoVec数组，并把其中的字转换为主机字节序。
+//	返回所有缓冲区的总长度，数组非法或总长度超过地址空间时返回-1
+//	（逐项比较剩余的长度，累加不会溢出）。
+//----------------------------------------------------------------------
+static int CopyInIoVec(int vaddr, int iovcnt, IoVec *iov) {
+	if (iovcnt <= 0 || iovcnt > MaxIoVecs)
+		return -1;
+	if (!CopyIn(vaddr, (char*) iov, iovcnt * sizeof(IoVec)))
+		return -1;
+	int total = 0;
+	for (int i = 0; i < iovcnt; i++) {
+		iov[i].base = (char*) WordToHost((unsigned int) iov[i].base);
+		iov[i].len = WordToHost((unsigned int) iov[i].len);
+		if (iov[i].len < 0 || iov[i].len > MaxUserBuffer() - total)
+			return -1;
+		total += iov[i].len;
+	}
+	return total;
+}
+
+//----------------------------------------------------------------------
+// StartExecProcess
+// 	Exec创建的线程的入口。参数由父进程在Exec时准备：可执行文件名和
+//	复制好的文件描述符（父进程可能先于子进程退出，所以不能引用父进程的
+//	描述符表）。与StartProcess相同，装入程序后不再返回。
+//----------------------------------------------------------------------
+class ExecArgs {
+public:
+	char name[MaxUserString];
+	OpenFile* files[MaxOpenFiles];
+};
+
+static void StartExecProcess(int arg) {
+	ExecArgs* args = (ExecArgs*) arg;
+	OpenFile* executable = fileSystem->Open(args->name);
+	if (executable == NULL) {
+		printf("Unable to open file %s\n", args->name);
+		for (int i = 0; i < MaxOpenFiles; i++)
+			if (args->files[i] != NULL)
+				fileSystem->Close(args->files[i]);
+		delete args;
+		currentThread->Finish();
+	}
+	AddrSpace* space = new AddrSpace(executable);
+	fileSystem->Close(executable);
+	for (int i = 0; i < MaxOpenFiles; i++)
+		space->files[i] = args->files[i];
+	delete args;
+	currentThread->space = space;
+
+	space->InitRegisters(); // set the initial register values
+	space->RestoreState();  // load page table register
+	machine->Run();         // jump to the user progam
+	ASSERT(FALSE);
+}
+
+void SyscallHandler(int type) {
+	switch (type) {
+	case SC_Halt: {
+		DEBUG('a', "Shutdown, initiated by user program.\n");
+		interrupt->Halt();
+		break;
+	}
+	case SC_Exit: {
+//		printf("thread : %d is exit , Exit code is %d\n",currentThread->getTid(),
+//				machine->ReadRegister(4));
+
+		IntStatus oldLevel = interrupt->SetLevel(IntOff);
+		while (!currentThread->waitingList->IsEmpty()) {
+			Thread *t = (Thread *) currentThread->waitingList->Remove();
+			if (t != NULL) {
+				t->exitCode = machine->ReadRegister(4);
+				scheduler->ReadyToRun(t);
+			}
+		}
+		interrupt->SetLevel(oldLevel);
+
+		currentThread->space->MunmapAll(); // 写回映射文件的脏页
+		currentThread->space->CloseAll();
+		currentThread->Finish();
+		break;
+	}
+	case SC_Exec: {
+		ExecArgs* args = new ExecArgs;
+		if (CopyInString(machine->ReadRegister(4), args->name, MaxUserString) < 0) {
+			delete args;
+			machine->WriteRegister(2, -1);
+			break;
+		}
+		for (int i = 0; i < MaxOpenFiles; i++) { // 子进程继承文件描述符
+			OpenFile* file = currentThread->space->files[i];
+			args->files[i] = (file == NULL) ? NULL : fileSystem->Dup(file);
+		}
+		Thread* exec = new Thread("thread2");
+		exec->Fork(StartExecProcess, (void*) args);
+		machine->WriteRegister(2, exec->getTid());
+//		printf("execing prog %s, tid is :%d\n", name, exec->getTid());
+		break;
+	}
+	case SC_Fork: {
+		int func = machine->ReadRegister(4);
+
+		Thread* fork = new Thread("fork");
+
+		fork->StackAllocate(StartForkProcess, func);
+
+		AddrSpace* newspace = new AddrSpace(currentThread);
+		fork->space = newspace;
+
+//		printf("forking func addr %x in thread : %d\n", func, currentThread->getTid());
+		scheduler->ReadyToRun(fork);
+		break;
+	}
+	case SC_Yield: {
+//		printf("yield thread : %d\n", currentThread->getTid());
+		currentThread->Yield();
+		break;
+	}
+	case SC_Join: {
+		int tid = machine->ReadRegister(4);
+		Thread* waitFor = scheduler->getThreadByTid(tid);
+		waitFor->waitingList->Append((void*) currentThread);
+
+//		printf("thread %d join thread %d\n", currentThread->getTid(),
+//				waitFor->getTid());
+
+		IntStatus oldLevel = interrupt->SetLevel(IntOff);
+		currentThread->Sleep();
+		interrupt->SetLevel(oldLevel);
+
+		machine->WriteRegister(2, currentThread->exitCode);
+		break;
+	}
+	case SC_Create: {
+		char name[MaxUserString];
+		if (CopyInString(machine->ReadRegister(4), name, MaxUserString) < 0)
+			break;
+		fileSystem->Create(name, 0, TRUE);
+//		machine->WriteRegister(PCReg, machine->ReadRegister(NextPCReg));
+		break;
+	}
+	case SC_Open: {
+		char name[MaxUserString];
+		OpenFile* openfile = NULL;
+		if (CopyInString(machine->ReadRegister(4), name, MaxUserString) >= 0)
+			openfile = fileSystem->Open(name);
+		int fd = -1;
+		if (openfile != NULL) {
+			fd = currentThread->space->AllocFd(openfile);
+			if (fd == -1) // 描述符表已满
+				fileSystem->Close(openfile);
+		}
+		machine->WriteRegister(2, fd);
+//		machine->WriteRegister(PCReg, machine->ReadRegister(NextPCReg));
+		break;
+	}
+	case SC_Close: {
+		int fd = machine->ReadRegister(4);
+		OpenFile* file = currentThread->space->RemoveFd(fd);
+		if (file != NULL)
+			fileSystem->Close(file);
+//		machine->WriteRegister(PCReg, machine->ReadRegister(NextPCReg));
+		break;
+	}
+	case SC_Write: {
+		int buffer = machine->ReadRegister(4);
+		int size = machine->ReadRegister(5);
+		OpenFile* file = currentThread->space->GetFile(machine->ReadRegister(6));
+
+		if (file == NULL || size <= 0 || size > MaxUserBuffer())
+			break;
+		char* data = new char[size];
+		if (CopyIn(buffer, data, size))
+			fileSystem->fwrite(file, data, size);
+		delete[] data;
+//		machine->WriteRegister(PCReg, machine->ReadRegister(NextPCReg));
+		break;
+	}
+	case SC_Read: {
+		int buffer = machine->ReadRegister(4);
+		int size = machine->ReadRegister(5);
+		OpenFile* file = currentThread->space->GetFile(machine->ReadRegister(6));
+
+		int num = (file == NULL || size > MaxUserBuffer()) ? -1 : 0;
+		if (num == 0 && size > 0) {
+			char* data = new char[size];
+			num = fileSystem->fread(file, data, size);
+			if (num > 0 && !CopyOut(buffer, data, num))
+				num = -1;
+			delete[] data;
+		}
+		machine->WriteRegister(2, num);
+//		machine->WriteRegister(PCReg, machine->ReadRegister(NextPCReg));
+		break;
+	}
+	case SC_ReadV: {
+		// 一次读入总长度的数据，再依次分散到各个用户缓冲区
+		IoVec iov[MaxIoVecs];
+		int iovcnt = machine->ReadRegister(5);
+		OpenFile* file = currentThread->space->GetFile(machine->ReadRegister(6));
+		int total = CopyInIoVec(machine->ReadRegister(4), iovcnt, iov);
+
+		int num = -1;
+		if (file != NULL && total >= 0) {
+			char* data = new char[total];
+			num = fileSystem->fread(file, data, total);
+			for (int i = 0, done = 0; i < iovcnt && done < num; i++) {
+				int n = (iov[i].len < num - done) ? iov[i].len : num - done;
+				if (!CopyOut((int) iov[i].base, data + done, n)) {
+					num = -1;
+					break;
+				}
+				done += n;
+			}
+			delete[] data;
+		}
+		machine->WriteRegister(2, num);
+		break;
+	}
+	case SC_WriteV: {
+		// 把各个用户缓冲区收集到一起，在文件锁内一次写入
+		IoVec iov[MaxIoVecs];
+		int iovcnt = machine->ReadRegister(5);
+		OpenFile* file = currentThread->space->GetFile(machine->ReadRegister(6));
+		int total = CopyInIoVec(machine->ReadRegister(4), iovcnt, iov);
+
+		int num = -1;
+		if (file != NULL && total >= 0) {
+			char* data = new char[total];
+			int done = 0;
+			for (int i = 0; i < iovcnt; i++) {
+				if (!CopyIn((int) iov[i].base, data + done, iov[i].len))
+					break;
+				done += iov[i].len;
+			}
+			if (done == total)
+				num = fileSystem->fwrite(file, data, total);
+			delete[] data;
+		}
+		machine->WriteRegister(2, num);
+		break;
+	}
+	case SC_PRead: {
+		int buffer = machine->ReadRegister(4);
+		int size = machine->ReadRegister(5);
+		int offset = machine->ReadRegister(6);
+		OpenFile* file = currentThread->space->GetFile(machine->ReadRegister(7));
+
+		int num = (file == NULL || size > MaxUserBuffer()) ? -1 : 0;
+		if (num == 0 && size > 0) {
+			char* data = new char[size];
+			num = fileSystem->fpread(file, data, size, offset);
+			if (num > 0 && !CopyOut(buffer, data, num))
+				num = -1;
+			delete[] data;
+		}
+		machine->WriteRegister(2, num);
+		break;
+	}
+	case SC_PWrite: {
+		int buffer = machine->ReadRegister(4);
+		int size = machine->ReadRegister(5);
+		int offset = machine->ReadRegister(6);
+		OpenFile* file = currentThread->space->GetFile(machine->ReadRegister(7));
+
+		int num = (file == NULL || size > MaxUserBuffer()) ? -1 : 0;
+		if (num == 0 && size > 0) {
+			char* data = new char[size];
+			num = CopyIn(buffer, data, size) ?
+					fileSystem->fpwrite(file, data, size, offset) : -1;
+			delete[] data;
+		}
+		machine->WriteRegister(2, num);
+		break;
+	}
+	case SC_Sync: {
+		headerCache->Flush();
+		journal->Commit();
+		bufferCache->Flush();
+		break;
+	}
+	case SC_Fsync: {
+		// 只写回这个文件的数据扇区和文件头；目录和位图的修改已经在日志中，
+		// 随文件头一起提交
+		OpenFile* file = currentThread->space->GetFile(machine->ReadRegister(4));
+		machine->WriteRegister(2, (file == NULL) ? -1 : fileSystem->fsync(file));
+		break;
+	}
+	case SC_Mmap: {
+		char name[MaxUserString];
+		OpenFile* file = NULL;
+		if (CopyInString(machine->ReadRegister(4), name, MaxUserString) >= 0)
+			file = fileSystem->Open(name);
+		int addr = -1;
+		if (file != NULL) {
+			addr = currentThread->space->Mmap(file);
+			if (addr == -1)
+				fileSystem->Close(file);
+		}
+		machine->WriteRegister(2, addr);
+		break;
+	}
+	case SC_Munmap: {
+		int addr = machine->ReadRegister(4);
+		bool ok = currentThread->space->Munmap(addr);
+		machine->WriteRegister(2, ok ? 0 : -1);
+		break;
+	}
+	default:{
+		printf("wrong syscall type %d\n", type);
+		ASSERT(FALSE);
+	}
+	}
+
+}
+void ExceptionHandler(ExceptionType which) {
+	int type = machine->ReadRegister(2);
+
+	if (which == SyscallException) {
+		return SyscallHandler(type);
+	} else if (which == PageFaultException) {
+		/*
+		 虚拟内存缺页中断。
+		 1.对于TLB， 用需要替换的地址替换TLB中现有的某一项，应该查询页表找到对应项，再利用选择算法替换某一项
+		 2.对于页表，需要将对应的磁盘数据读取至内存，为其分配一个物理内存，并在页表中添加其转换关系。
+		 */
+		int badAddr = machine->ReadRegister(BadVAddrReg);
+		DEBUG('a', "Page fault exception of addr %x.\n", badAddr);
+		HandlePageFault(badAddr);
+	} else {
+		printf("Unexpected user mode exception %d %d\n", which, type);
+		ASSERT(FALSE);
+	}
+}